@@ -0,0 +1,65 @@
+#ifndef NETLIST_PATHS_CONDENSATION_HPP
+#define NETLIST_PATHS_CONDENSATION_HPP
+
+#include <cstdint>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+/// The strongly-connected components of a graph, and the directed acyclic
+/// graph formed by contracting each component to a single vertex. Components
+/// are determined with an iterative version of Tarjan's algorithm, so the
+/// depth of the graph is not limited by the call stack, and are numbered in
+/// topological order, so every edge of the condensed graph goes from a lower
+/// to a higher numbered component.
+class Condensation {
+  /// Component of each vertex.
+  std::vector<uint32_t> components;
+  /// Vertices of each component in compressed sparse row form.
+  std::vector<uint64_t> memberOffsets;
+  std::vector<VertexID> members;
+  /// Condensed graph in compressed sparse row form.
+  std::vector<uint64_t> dagOffsets;
+  std::vector<uint32_t> dagEdges;
+  /// Components that form combinational loops.
+  std::vector<uint32_t> loops;
+
+  void determineComponents(const InternalGraph &graph);
+  void determineMembers();
+  void determineEdges(const InternalGraph &graph);
+  void determineLoops(const InternalGraph &graph);
+
+public:
+  Condensation() = delete;
+  Condensation(const Graph &graph);
+  std::size_t getNumComponents() const { return memberOffsets.size() - 1; }
+  uint32_t getComponent(VertexID vertex) const { return components[vertex]; }
+  const std::vector<uint32_t> &getComponents() const { return components; }
+  const std::vector<uint64_t> &getDAGOffsets() const { return dagOffsets; }
+  const std::vector<uint32_t> &getDAGEdges() const { return dagEdges; }
+  /// Iterate the vertices in a component.
+  const VertexID *membersBegin(uint32_t component) const {
+    return members.data() + memberOffsets[component];
+  }
+  const VertexID *membersEnd(uint32_t component) const {
+    return members.data() + memberOffsets[component + 1];
+  }
+  std::size_t getNumMembers(uint32_t component) const {
+    return memberOffsets[component + 1] - memberOffsets[component];
+  }
+  /// Iterate the successors of a component in the condensed graph.
+  const uint32_t *successorsBegin(uint32_t component) const {
+    return dagEdges.data() + dagOffsets[component];
+  }
+  const uint32_t *successorsEnd(uint32_t component) const {
+    return dagEdges.data() + dagOffsets[component + 1];
+  }
+  /// Return the components that contain a combinational loop, in
+  /// topological order.
+  const std::vector<uint32_t> &getLoops() const { return loops; }
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_CONDENSATION_HPP
@@ -1,7 +1,12 @@
 #ifndef NETLIST_PATHS_GRAPH_HPP
 #define NETLIST_PATHS_GRAPH_HPP
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/tokenizer.hpp>
@@ -17,24 +22,122 @@ using InternalGraph = boost::adjacency_list<boost::vecS,
 using VertexID = boost::graph_traits<InternalGraph>::vertex_descriptor;
 using ParentMap = std::map<VertexID, std::vector<VertexID>>;
 using VertexIDVec = std::vector<VertexID>;
+using VertexIDPair = std::pair<VertexID, VertexID>;
+
+/// Buffers reused by successive traversals of a graph, so that they do not
+/// allocate or clear per-vertex state each time. A vertex is marked as
+/// visited by the number of the traversal that reached it, and the vertices
+/// reached are listed in the order they were visited.
+struct TraversalScratch {
+  struct Frame {
+    VertexID vertex;
+    std::size_t next;
+    std::size_t end;
+  };
+  std::vector<uint32_t> visited;
+  VertexIDVec parents;
+  std::vector<Frame> stack;
+  VertexIDVec reached;
+  VertexIDVec frontier;
+  VertexIDVec nextFrontier;
+  std::vector<uint64_t> frontierBits;
+  uint32_t traversal = 0;
+
+  /// Begin a new traversal of a graph with numVertices vertices.
+  void reset(std::size_t numVertices) {
+    if (visited.size() != numVertices || ++traversal == 0) {
+      visited.assign(numVertices, 0);
+      parents.resize(numVertices);
+      traversal = 1;
+    }
+    stack.clear();
+    reached.clear();
+  }
+  bool isVisited(VertexID vertex) const { return visited[vertex] == traversal; }
+  void visit(VertexID vertex, VertexID parent) {
+    visited[vertex] = traversal;
+    parents[vertex] = parent;
+  }
+};
+
+/// Hit and miss counts and the occupancy of a traversal cache.
+struct TraversalCacheStats {
+  uint64_t hits;
+  uint64_t misses;
+  std::size_t numEntries;
+  std::size_t numBytes;
+};
+
+/// The named vertices ordered by name, and the position of each vertex in
+/// that order.
+struct NameOrder {
+  VertexIDVec vertices;
+  std::vector<std::size_t> positions;
+};
+
+class Condensation;
+class LogicDepth;
+class NameIndex;
+class NameMatcher;
+class PathEnumerator;
+class ReachabilityIndex;
+class RegisterGraph;
+class TraversalCache;
+class TraversalTree;
 
 class Graph {
 private:
   InternalGraph graph;
+  std::unique_ptr<NameIndex> nameIndex;
+  mutable std::mutex condensationMutex;
+  mutable std::shared_ptr<const Condensation> condensation;
+  mutable std::mutex logicDepthMutex;
+  mutable std::shared_ptr<const LogicDepth> logicDepth;
+  mutable std::mutex registerGraphMutex;
+  mutable std::shared_ptr<const RegisterGraph> registerGraph;
+  mutable std::mutex traversalCacheMutex;
+  mutable std::shared_ptr<TraversalCache> traversalCache;
+  mutable std::mutex nameOrderMutex;
+  mutable std::shared_ptr<const NameOrder> nameOrder;
+
+  friend class Condensation;
+  friend class LogicDepth;
+  friend class ReachabilityIndex;
+  friend class RegisterGraph;
 
   void dumpPath(const VertexIDVec &path) const;
   VertexIDVec determinePath(ParentMap &parentMap,
                             VertexIDVec path,
                             VertexID startVertexId,
                             VertexID endVertexId) const;
-  void determineAllPaths(ParentMap &parentMap,
-                         std::vector<VertexIDVec> &result,
-                         VertexIDVec path,
-                         VertexID startVertex,
-                         VertexID endVertex) const;
+  bool traverseDFS(VertexID root, bool reverse, TraversalScratch &scratch,
+                   std::size_t maxVertices,
+                   const std::vector<bool> &avoid) const;
+  void traverseBFS(bool reverse, TraversalScratch &scratch,
+                   unsigned numThreads, const std::vector<bool> &avoid) const;
+  bool traverse(VertexID root, bool reverse, TraversalScratch &scratch,
+                unsigned numThreads, const std::vector<bool> &avoid) const;
+  TraversalCache &getTraversalCache() const;
+  std::shared_ptr<const TraversalTree> getTraversalTree(VertexID root,
+                                                        bool reverse,
+                                                        bool depthFirst,
+                                                        TraversalScratch &scratch,
+                                                        unsigned numThreads,
+                                                        const std::vector<bool> &avoid) const;
+  std::vector<VertexIDVec> determineFanPaths(VertexID vertex, bool reverse,
+                                             TraversalScratch &scratch,
+                                             unsigned numThreads,
+                                             const std::vector<bool> &avoid) const;
+  std::vector<std::pair<VertexID, size_t>> determineDegrees(bool fanIn) const;
+  void propagateReachability(const VertexID *startVertices,
+                             std::size_t numStartVertices,
+                             const std::vector<bool> &avoid,
+                             std::vector<uint64_t> &reached,
+                             std::vector<bool> &queued) const;
 
 public:
-  Graph() {}
+  Graph();
+  ~Graph();
   VertexID addLogicVertex(VertexAstType type, Location location) {
     auto vertex = Vertex(type, location);
     return boost::add_vertex(vertex, graph);
@@ -46,11 +149,7 @@ public:
                         const std::string &name,
                         bool isParam,
                         const std::string &paramValue,
-                        bool isPublic) {
-    auto vertex = Vertex(type, direction, location, dtype, name, isParam,
-                         paramValue, isPublic);
-    return boost::add_vertex(vertex, graph);
-  }
+                        bool isPublic);
   void addEdge(VertexID src, VertexID dst) {
     boost::add_edge(src, dst, graph);
   }
@@ -61,8 +160,8 @@ public:
     graph[vertex].setDirection(direction);
   }
   VertexID nullVertex() const { return boost::graph_traits<InternalGraph>::null_vertex(); }
-  std::size_t numVertices() { return boost::num_vertices(graph); }
-  std::size_t numEdges() { return boost::num_edges(graph); }
+  std::size_t numVertices() const { return boost::num_vertices(graph); }
+  std::size_t numEdges() const { return boost::num_edges(graph); }
   void splitRegVertices();
   void checkGraph() const;
   void dumpDotFile(const std::string &outputFilename) const;
@@ -70,6 +169,20 @@ public:
   VertexID getVertexDesc(const std::string &name) const;
   VertexID getVertexDescRegex(const std::string &name,
                                 VertexGraphType graphType) const;
+  void forEachNameMatch(const NameMatcher &matcher,
+                        const std::function<bool(VertexID)> &fn) const;
+  VertexIDVec getVerticesRegex(const std::string &name) const;
+  std::vector<VertexIDVec> getVerticesRegex(
+      const std::vector<std::pair<std::string, VertexGraphType>> &patterns) const;
+  VertexIDVec getVerticesInScope(const std::string &scope) const;
+  std::vector<std::string> getChildScopes(const std::string &scope) const;
+  std::vector<VertexIDVec> getPathsLeavingScope(const std::string &scope) const;
+  const NameOrder &getNameOrder() const;
+  void sortByName(VertexIDVec &vertices) const;
+  std::pair<std::size_t, std::size_t>
+  getNamePrefixRange(const std::string &prefix) const;
+  bool isTop(VertexID vertex) const;
+  const std::string &getBasename(VertexID vertex) const;
   VertexID getStartVertex(const std::string &name) const {
     return getVertexDescRegex(name, VertexGraphType::START_POINT);
   }
@@ -82,12 +195,45 @@ public:
   VertexID getRegVertex(const std::string &name) const {
     return getVertexDescRegex(name, VertexGraphType::REG);
   }
-  std::vector<VertexIDVec> getAllFanOut(VertexID startVertex) const;
-  std::vector<VertexIDVec> getAllFanIn(VertexID endVertex) const;
-  size_t getfanOutDegree(VertexID startVertex);
-  size_t getFanInDegree(VertexID endVertex);
-  VertexIDVec getAnyPointToPoint(const std::vector<VertexID> &waypoints) const;
-  std::vector<VertexIDVec> getAllPointToPoint(const std::vector<VertexID> &waypoints) const;
+  std::vector<VertexIDVec> getAllFanOut(VertexID startVertex,
+                                        const std::vector<bool> &avoid={}) const;
+  std::vector<VertexIDVec> getAllFanIn(VertexID endVertex,
+                                       const std::vector<bool> &avoid={}) const;
+  std::vector<std::vector<VertexIDVec>> getAllFanOut(const VertexIDVec &startVertices,
+                                                     const std::vector<bool> &avoid={}) const;
+  std::vector<std::vector<VertexIDVec>> getAllFanIn(const VertexIDVec &endVertices,
+                                                    const std::vector<bool> &avoid={}) const;
+  size_t getfanOutDegree(VertexID startVertex) const;
+  size_t getFanInDegree(VertexID endVertex) const;
+  std::vector<std::pair<VertexID, size_t>> getAllFanOutDegrees() const;
+  std::vector<std::pair<VertexID, size_t>> getAllFanInDegrees() const;
+  VertexIDVec getAnyPointToPoint(const std::vector<VertexID> &waypoints,
+                                 const std::vector<bool> &avoid={}) const;
+  std::vector<bool> getPointToPointReachability(const std::vector<VertexIDPair> &pairs,
+                                                const std::vector<bool> &avoid={}) const;
+  std::vector<std::vector<bool>> getReachabilityMatrix(const VertexIDVec &startVertices,
+                                                       const VertexIDVec &finishVertices,
+                                                       const std::vector<bool> &avoid={}) const;
+  std::vector<std::vector<VertexIDVec>> getMatrixPaths(const VertexIDVec &startVertices,
+                                                       const VertexIDVec &finishVertices,
+                                                       const std::vector<std::vector<bool>> &connected,
+                                                       const std::vector<bool> &avoid={}) const;
+  const Condensation &getCondensation() const;
+  std::vector<VertexIDVec> getCombLoops() const;
+  const LogicDepth &getLogicDepth() const;
+  const RegisterGraph &getRegisterGraph() const;
+  TraversalCacheStats getTraversalCacheStats() const;
+  void clearTraversalCache() const;
+  std::vector<VertexIDVec> getAllPointToPoint(const std::vector<VertexID> &waypoints,
+                                              const std::vector<bool> &avoid={}) const;
+  std::unique_ptr<PathEnumerator>
+  enumerateAllPointToPoint(const std::vector<VertexID> &waypoints,
+                           const std::vector<bool> &avoid={}) const;
+  std::unique_ptr<PathEnumerator> enumerateFanPaths(VertexID vertex,
+                                                    bool reverse,
+                                                    const std::vector<bool> &avoid={}) const;
+  VertexIDVec getCone(const VertexIDVec &roots, bool reverse) const;
+  void copySubgraph(const VertexIDVec &vertices, Graph &subgraph) const;
   const Vertex &getVertex(VertexID vertexId) const { return graph[vertexId]; }
   Vertex* getVertexPtr(VertexID vertexId) const {
     // Remove the const cast to make it compatible with the boost::python wrappers.
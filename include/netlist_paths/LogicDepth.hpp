@@ -0,0 +1,52 @@
+#ifndef NETLIST_PATHS_LOGIC_DEPTH_HPP
+#define NETLIST_PATHS_LOGIC_DEPTH_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+/// The logic depth of each vertex: the maximum number of logic vertices on a
+/// path to it from any start point. Depths are determined by dynamic
+/// programming over the condensed graph in topological order, so the longest
+/// paths are found in time linear in the size of the graph. Combinational
+/// loops have no longest path, so their vertices, and any vertices only
+/// reachable through them, are not given a depth. Components without logic
+/// (ports and their aliases) are treated as a single vertex.
+class LogicDepth {
+public:
+  /// Depth statistics of the finish points in one module instance, given by
+  /// the hierarchical prefix of their names.
+  struct ModuleStats {
+    std::string name;
+    std::size_t numFinishPoints;
+    std::size_t maxDepth;
+    std::size_t totalDepth;
+  };
+
+private:
+  const Graph &graph;
+  /// The depth of each vertex, or -1 if it is not reachable.
+  std::vector<int> depths;
+  /// The predecessor of each vertex on its longest path.
+  VertexIDVec parents;
+
+  void determineDepths();
+
+public:
+  LogicDepth() = delete;
+  LogicDepth(const Graph &graph);
+  int getDepth(VertexID vertex) const { return depths[vertex]; }
+  VertexIDVec getPath(VertexID finishVertex) const;
+  std::vector<std::pair<VertexID, std::size_t>> getFinishDepths() const;
+  std::vector<std::pair<VertexID, std::size_t>> getDeepest(std::size_t k) const;
+  std::vector<std::size_t> getHistogram() const;
+  std::vector<ModuleStats> getModuleStats() const;
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_LOGIC_DEPTH_HPP
@@ -0,0 +1,154 @@
+#ifndef NETLIST_PATHS_NAME_INDEX_HPP
+#define NETLIST_PATHS_NAME_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+/// An index of the names of the vertices of a graph, maintained as vertices
+/// are added. A hash map gives the first vertex with each exact name, and a
+/// trie of the hierarchical components of the names ('.'-separated, or
+/// '/'-separated in queries) forms the instance hierarchy. Each vertex refers
+/// to the trie node its name ends at, which gives its depth and basename
+/// directly. The vertices are also kept in a pre-order of the trie, so the
+/// vertices within any instance form a contiguous range and membership of an
+/// instance is a comparison of node numbers. The names are also stored
+/// contiguously, each followed by a newline, for fast substring searches.
+class NameIndex {
+public:
+  static constexpr uint32_t NULL_NODE = UINT32_MAX;
+
+private:
+  struct Node {
+    /// Child components, ordered by name.
+    std::map<std::string, uint32_t> children;
+    /// Vertices whose full name ends at this node, in the order added.
+    VertexIDVec vertices;
+    /// The last component of the node's name, owned by the parent's map.
+    const std::string *component;
+    uint32_t depth;
+  };
+
+  /// The position of a node in a pre-order traversal of the trie, the end of
+  /// its subtree's positions, and the range of its subtree's vertices (after
+  /// its own vertices) in rangeVertices.
+  struct Range {
+    uint32_t first;
+    uint32_t last;
+    std::size_t vertexBegin;
+    std::size_t vertexEnd;
+  };
+
+  std::unordered_map<std::string, VertexID> exact;
+  /// Trie nodes, with the root (the empty scope) first.
+  std::vector<Node> nodes;
+  /// The node of each vertex, indexed by vertex.
+  std::vector<uint32_t> vertexNodes;
+  /// The names in the order added, the offset of each in the blob and its
+  /// vertex.
+  std::string blob;
+  std::vector<std::size_t> blobOffsets;
+  VertexIDVec blobVertices;
+  /// The pre-order ranges, built on demand after vertices are added.
+  mutable std::mutex rangesMutex;
+  mutable bool rangesValid;
+  mutable std::vector<Range> ranges;
+  mutable VertexIDVec rangeVertices;
+
+  const Node *findNode(const std::string &scope) const;
+  /// Return the node of a vertex's name, or NULL_NODE if the vertex has no
+  /// name in the index. The root, the node of an empty name, has no name.
+  uint32_t getNode(VertexID vertex) const {
+    if (vertex >= vertexNodes.size() || vertexNodes[vertex] == NULL_NODE ||
+        vertexNodes[vertex] == 0) {
+      return NULL_NODE;
+    }
+    return vertexNodes[vertex];
+  }
+  void updateRanges() const;
+  void buildRanges(uint32_t node, uint32_t &position) const;
+
+public:
+  NameIndex() : nodes(1, Node{{}, {}, nullptr, 0}), rangesValid(false) {}
+  void insert(const std::string &name, VertexID vertex);
+  /// Return the first vertex added with a name, or the null vertex.
+  VertexID lookup(const std::string &name) const {
+    auto it = exact.find(name);
+    return it != exact.end() ? it->second
+                             : boost::graph_traits<InternalGraph>::null_vertex();
+  }
+  /// Return the node of a scope, or NULL_NODE if there are no names within
+  /// it.
+  uint32_t findScope(const std::string &scope) const {
+    auto node = findNode(scope);
+    if (!node) {
+      return NULL_NODE;
+    }
+    updateRanges();
+    return static_cast<uint32_t>(node - nodes.data());
+  }
+  /// Return true if a vertex has a name within (below) a scope node returned
+  /// by findScope, with no vertices added since.
+  bool isWithin(VertexID vertex, uint32_t scope) const {
+    if (vertex >= vertexNodes.size() || vertexNodes[vertex] == NULL_NODE) {
+      return false;
+    }
+    auto position = ranges[vertexNodes[vertex]].first;
+    return position > ranges[scope].first && position < ranges[scope].last;
+  }
+  /// Return true if a vertex's name has fewer than three components, ie it is
+  /// a top-level port (name) or a variable of the top module (module.name).
+  /// Vertices without a name in the index are not top.
+  bool isTop(VertexID vertex) const {
+    auto node = getNode(vertex);
+    return node != NULL_NODE && nodes[node].depth < 3;
+  }
+  /// Return the last component of a vertex's name, or an empty string if it
+  /// has no name in the index.
+  const std::string &getBasename(VertexID vertex) const {
+    static const std::string empty;
+    auto node = getNode(vertex);
+    return node != NULL_NODE ? *nodes[node].component : empty;
+  }
+  /// Return the vertices with names within a scope, ordered by vertex.
+  VertexIDVec getVerticesInScope(const std::string &scope) const;
+  /// Return the names of the scopes directly within a scope.
+  std::vector<std::string> getChildScopes(const std::string &scope) const;
+  /// Return the vertices with names, in the order added.
+  const VertexIDVec &getVertices() const { return blobVertices; }
+  /// Call fn(vertex) for each vertex whose name contains a literal, in the
+  /// order added, until it returns false. The names are searched with memmem,
+  /// which is vectorised, jumping from each hit to the start of the next name.
+  template<typename Fn>
+  void forEachContaining(const std::string &literal, Fn fn) const {
+    auto begin = blob.data();
+    auto end = begin + blob.size();
+    auto pos = begin;
+    while (pos < end) {
+      auto hit = static_cast<const char*>(
+          memmem(pos, end - pos, literal.data(), literal.size()));
+      if (!hit) {
+        return;
+      }
+      auto it = std::upper_bound(std::begin(blobOffsets), std::end(blobOffsets),
+                                 static_cast<std::size_t>(hit - begin));
+      auto index = std::distance(std::begin(blobOffsets), it) - 1;
+      if (!fn(blobVertices[index])) {
+        return;
+      }
+      pos = it != std::end(blobOffsets) ? begin + *it : end;
+    }
+  }
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_NAME_INDEX_HPP
@@ -0,0 +1,60 @@
+#ifndef NETLIST_PATHS_NAME_MATCHER_HPP
+#define NETLIST_PATHS_NAME_MATCHER_HPP
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace netlist_paths {
+
+/// A compiled pattern for matching vertex names, with the same results as
+/// std::regex_search on the pattern. In wildcard mode '?' matches any
+/// character and '*' any sequence of characters; in regex mode the pattern is
+/// a regular expression. If separatorsAsAny is set, '/' and '_' match any
+/// character, so hierarchical and flattened names can be given.
+///
+/// Patterns made only of literal characters, any-character wildcards ('.' in
+/// either mode), any-sequence wildcards ('*' in wildcard mode, an
+/// any-character followed by '*' in regex mode) and '^' and '$' anchors are
+/// matched directly, as a series of literal segments separated by
+/// any-sequence wildcards, without allocating. Other patterns fall back to
+/// std::regex.
+class NameMatcher {
+  /// Marks an any-character position in a segment.
+  static constexpr char ANY = '\0';
+
+  struct Segment {
+    std::string chars;
+    bool hasAny;
+  };
+
+  bool useRegex;
+  std::regex regex;
+  bool anchorStart;
+  bool anchorEnd;
+  /// Segments separated by any-sequence wildcards.
+  std::vector<Segment> segments;
+  /// A literal that every matching name contains, or empty.
+  std::string requiredLiteral;
+
+  bool compile(const std::string &pattern, bool wildcard, bool separatorsAsAny);
+  void determineSegmentsLiteral();
+  static std::string determineRegexLiteral(const std::string &regexStr);
+  static bool matchAt(const std::string &name, std::size_t pos,
+                      const Segment &segment);
+  static std::size_t find(const std::string &name, std::size_t pos,
+                          const Segment &segment);
+
+public:
+  NameMatcher(const std::string &pattern, bool wildcard, bool separatorsAsAny);
+  bool match(const std::string &name) const;
+  /// Whether the pattern is matched without std::regex.
+  bool isCompiled() const { return !useRegex; }
+  /// Return the longest literal that every matching name must contain, which
+  /// can be used to screen candidates, or an empty string if there is none.
+  const std::string &getRequiredLiteral() const { return requiredLiteral; }
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_NAME_MATCHER_HPP
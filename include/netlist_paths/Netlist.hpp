@@ -2,11 +2,16 @@
 #define NETLIST_PATHS_NETLIST_HPP
 
 #include <memory>
+#include <mutex>
 #include <iostream>
 #include <ostream>
 #include "netlist_paths/Exception.hpp"
 #include "netlist_paths/Graph.hpp"
+#include "netlist_paths/LogicDepth.hpp"
 #include "netlist_paths/Options.hpp"
+#include "netlist_paths/PathEnumerator.hpp"
+#include "netlist_paths/QueryContext.hpp"
+#include "netlist_paths/ReachabilityIndex.hpp"
 #include "netlist_paths/ReadVerilatorXML.hpp"
 #include "netlist_paths/Waypoints.hpp"
 
@@ -18,6 +23,8 @@ class Netlist {
   std::vector<File> files;
   std::vector<std::shared_ptr<DType>> dtypes;
   std::vector<VertexID> waypoints;
+  mutable std::mutex reachabilityIndexMutex;
+  std::shared_ptr<const ReachabilityIndex> reachabilityIndex;
 
   /// Get a DType by name.
   const std::shared_ptr<DType> getDType(const std::string &name) const {
@@ -50,6 +57,22 @@ class Netlist {
     return result;
   }
 
+  std::vector<std::pair<Vertex*, std::size_t> >
+  createVertexPtrCountVec(const std::vector<std::pair<VertexID, std::size_t> > &counts) const {
+    auto result = std::vector<std::pair<Vertex*, std::size_t> >();
+    for (auto &count : counts) {
+      result.emplace_back(netlist.getVertexPtr(count.first), count.second);
+    }
+    return result;
+  }
+
+  /// Construct a netlist from a subset of the vertices of another, in vertex
+  /// order.
+  Netlist(const Netlist &parent, const VertexIDVec &vertices) :
+      files(parent.files), dtypes(parent.dtypes) {
+    parent.netlist.copySubgraph(vertices, netlist);
+  }
+
 public:
   Netlist() = delete;
   Netlist(const std::string &filename) {
@@ -58,6 +81,24 @@ public:
     netlist.checkGraph();
   }
 
+  std::size_t numVertices() const { return netlist.numVertices(); }
+  std::size_t numEdges() const { return netlist.numEdges(); }
+
+  /// Return the hit and miss counts of the cache of traversal results, which
+  /// is sized by the traversal cache size option.
+  TraversalCacheStats getTraversalCacheStats() const {
+    return netlist.getTraversalCacheStats();
+  }
+
+  /// Empty the cache of traversal results and reset its statistics.
+  void clearTraversalCache() const { netlist.clearTraversalCache(); }
+
+  /// Return a new netlist containing only the fan in cone and/or fan out cone
+  /// of a set of points. The new netlist is independent of this one, with
+  /// its own vertex numbering, but shares data types and source locations.
+  std::unique_ptr<Netlist> extractCone(const std::vector<std::string> &names,
+                                       bool fanIn, bool fanOut) const;
+
   //===--------------------------------------------------------------------===//
   // Reporting of names and types.
   //===--------------------------------------------------------------------===//
@@ -90,11 +131,50 @@ public:
     }
   }
 
+  //===--------------------------------------------------------------------===//
+  // Reachability index.
+  //===--------------------------------------------------------------------===//
+
+  /// Build an index to answer path existence queries without searching.
+  void buildReachabilityIndex() {
+    setReachabilityIndex(std::make_shared<const ReachabilityIndex>(netlist));
+  }
+
+  /// Load a reachability index previously saved for this netlist.
+  void loadReachabilityIndex(const std::string &filename) {
+    setReachabilityIndex(
+        std::make_shared<const ReachabilityIndex>(netlist, filename));
+  }
+
+  void saveReachabilityIndex(const std::string &filename) const {
+    auto index = getReachabilityIndex();
+    if (!index) {
+      throw Exception("no reachability index has been built");
+    }
+    index->save(filename);
+  }
+
+  /// Return the reachability index, or null. Queries hold a reference to the
+  /// index, so it can be replaced while they run.
+  std::shared_ptr<const ReachabilityIndex> getReachabilityIndex() const {
+    std::lock_guard<std::mutex> lock(reachabilityIndexMutex);
+    return reachabilityIndex;
+  }
+
+  void setReachabilityIndex(std::shared_ptr<const ReachabilityIndex> index) {
+    std::lock_guard<std::mutex> lock(reachabilityIndexMutex);
+    reachabilityIndex = std::move(index);
+  }
+
+  bool hasReachabilityIndex() const { return getReachabilityIndex() != nullptr; }
+
   //===--------------------------------------------------------------------===//
   // Waypoints.
   //===--------------------------------------------------------------------===//
 
   VertexIDVec readWaypoints(Waypoints waypoints) const;
+  std::vector<bool> readAvoidPoints(const Waypoints &waypoints) const;
+  std::vector<bool> readAvoidPoints(const std::vector<std::string> &avoidPoints) const;
 
   //===--------------------------------------------------------------------===//
   // Basic path querying.
@@ -113,39 +193,269 @@ public:
   }
 
   /// Return a Boolean to indicate whether any path exists between two points.
-  bool pathExists(Waypoints waypoints) {
+  /// If a reachability index is available, it is used instead of a search.
+  /// The index is not used when the waypoints have avoid points.
+  bool pathExists(Waypoints waypoints) const {
     auto waypointIDs = readWaypoints(waypoints);
-    return !netlist.getAnyPointToPoint(waypointIDs).empty();
+    auto avoid = readAvoidPoints(waypoints);
+    auto reachabilityIndex = getReachabilityIndex();
+    if (reachabilityIndex && avoid.empty()) {
+      for (std::size_t i = 0; i < waypointIDs.size()-1; ++i) {
+        if (!reachabilityIndex->reachable(waypointIDs[i], waypointIDs[i+1])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    return !netlist.getAnyPointToPoint(waypointIDs, avoid).empty();
   }
 
+  /// Return a vector of Booleans indicating whether any path exists between
+  /// each set of waypoints. Queries without through or avoid points are
+  /// answered together, with one traversal per distinct start point.
+  std::vector<bool> pathsExist(std::vector<Waypoints> waypointsList) const;
+
+  /// The connectivity of every start point matching one pattern to every
+  /// finish point matching another.
+  struct PathMatrix {
+    std::vector<Vertex*> startPoints;
+    std::vector<Vertex*> finishPoints;
+    /// Indexed by start point, then finish point.
+    std::vector<std::vector<bool>> connected;
+    /// An example path for each connected pair, if requested, otherwise empty.
+    std::vector<std::vector<std::vector<Vertex*>>> paths;
+  };
+
+  /// Return which of the start points matching startPattern have a path to
+  /// each of the finish points matching finishPattern, not passing through
+  /// any vertex matching an avoid point. Both patterns are resolved in one
+  /// scan of the names, and the pairs are answered together, with one
+  /// traversal per group of start points. If withPaths is set, a path for
+  /// each connected pair is found with one traversal per start point.
+  PathMatrix getPathMatrix(const std::string &startPattern,
+                           const std::string &finishPattern,
+                           bool withPaths=false,
+                           const std::vector<std::string> &avoidPoints={}) const;
+
   /// Return any path between two points.
   std::vector<Vertex*> getAnyPath(Waypoints waypoints) {
+    return createVertexPtrVec(getAnyPathIds(waypoints));
+  }
+
+  VertexIDVec getAnyPathIds(Waypoints waypoints) const {
     auto waypointIDs = readWaypoints(waypoints);
-    return createVertexPtrVec(netlist.getAnyPointToPoint(waypointIDs));
+    auto avoid = readAvoidPoints(waypoints);
+    return netlist.getAnyPointToPoint(waypointIDs, avoid);
   }
 
   /// Return any path between two points.
   std::vector<std::vector<Vertex*> > getAllPaths(Waypoints waypoints) {
+    return createVertexPtrVecVec(getAllPathsIds(waypoints));
+  }
+
+  std::vector<VertexIDVec> getAllPathsIds(Waypoints waypoints) const {
+    auto waypointIDs = readWaypoints(waypoints);
+    auto avoid = readAvoidPoints(waypoints);
+    return netlist.getAllPointToPoint(waypointIDs, avoid);
+  }
+
+  /// Return a vector of paths fanning out from a particular start point,
+  /// not passing through any vertex matching an avoid point.
+  std::vector<std::vector<Vertex*> >
+  getAllFanOut(const std::string startName,
+               const std::vector<std::string> &avoidPoints={}) const {
+    return createVertexPtrVecVec(getAllFanOutIds(startName, avoidPoints));
+  }
+
+  std::vector<VertexIDVec>
+  getAllFanOutIds(const std::string &startName,
+                  const std::vector<std::string> &avoidPoints={}) const {
+    auto startVertex = netlist.getStartVertex(startName);
+    if (startVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find start vertex "+startName));
+    }
+    return netlist.getAllFanOut(startVertex, readAvoidPoints(avoidPoints));
+  }
+
+  /// Return a vector of paths fanning out from a particular start point,
+  /// not passing through any vertex matching an avoid point.
+  std::vector<std::vector<Vertex*> >
+  getAllFanIn(const std::string finishName,
+              const std::vector<std::string> &avoidPoints={}) const {
+    return createVertexPtrVecVec(getAllFanInIds(finishName, avoidPoints));
+  }
+
+  std::vector<VertexIDVec>
+  getAllFanInIds(const std::string &finishName,
+                 const std::vector<std::string> &avoidPoints={}) const {
+    auto finishVertex = netlist.getEndVertex(finishName);
+    if (finishVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find finish vertex "+finishName));
+    }
+    return netlist.getAllFanIn(finishVertex, readAvoidPoints(avoidPoints));
+  }
+
+  /// Return an enumerator of all the paths between two points, which produces
+  /// them one at a time, in the same order as getAllPaths.
+  std::unique_ptr<PathEnumerator> getAllPathsEnumerator(Waypoints waypoints) const {
     auto waypointIDs = readWaypoints(waypoints);
-    return createVertexPtrVecVec(netlist.getAllPointToPoint(waypointIDs));
+    auto avoid = readAvoidPoints(waypoints);
+    return netlist.enumerateAllPointToPoint(waypointIDs, avoid);
   }
 
-  /// Return a vector of paths fanning out from a particular start point.
-  std::vector<std::vector<Vertex*> > getAllFanOut(const std::string startName) const {
+  /// Return an enumerator of the paths fanning out from a start point, in the
+  /// same order as getAllFanOut.
+  std::unique_ptr<PathEnumerator>
+  getAllFanOutEnumerator(const std::string &startName,
+                         const std::vector<std::string> &avoidPoints={}) const {
     auto startVertex = netlist.getStartVertex(startName);
     if (startVertex == netlist.nullVertex()) {
       throw Exception(std::string("could not find start vertex "+startName));
     }
-    return createVertexPtrVecVec(netlist.getAllFanOut(startVertex));
+    return netlist.enumerateFanPaths(startVertex, false,
+                                     readAvoidPoints(avoidPoints));
   }
 
-  /// Return a vector of paths fanning out from a particular start point.
-  std::vector<std::vector<Vertex*> > getAllFanIn(const std::string finishName) const {
+  /// Return an enumerator of the paths fanning in to a finish point, in the
+  /// same order as getAllFanIn.
+  std::unique_ptr<PathEnumerator>
+  getAllFanInEnumerator(const std::string &finishName,
+                        const std::vector<std::string> &avoidPoints={}) const {
     auto finishVertex = netlist.getEndVertex(finishName);
     if (finishVertex == netlist.nullVertex()) {
       throw Exception(std::string("could not find finish vertex "+finishName));
     }
-    return createVertexPtrVecVec(netlist.getAllFanIn(finishVertex));
+    return netlist.enumerateFanPaths(finishVertex, true,
+                                     readAvoidPoints(avoidPoints));
+  }
+
+  /// Return a vector of paths fanning out from each of a set of start points,
+  /// in the same order as the start points, not passing through any vertex
+  /// matching an avoid point. The start points are processed in parallel.
+  std::vector<std::vector<std::vector<Vertex*> > >
+  getAllFanOutMulti(const std::vector<std::string> &startNames,
+                    const std::vector<std::string> &avoidPoints={}) const;
+
+  /// Return a vector of paths fanning in to each of a set of finish points,
+  /// in the same order as the finish points, not passing through any vertex
+  /// matching an avoid point. The finish points are processed in parallel.
+  std::vector<std::vector<std::vector<Vertex*> > >
+  getAllFanInMulti(const std::vector<std::string> &finishNames,
+                   const std::vector<std::string> &avoidPoints={}) const;
+
+  //===--------------------------------------------------------------------===//
+  // Columnar exports.
+  //===--------------------------------------------------------------------===//
+
+  /// A list of paths in compressed sparse row form: the vertex IDs of path i
+  /// are vertices[offsets[i]] to vertices[offsets[i+1]-1].
+  struct PathArrays {
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> vertices;
+  };
+
+  /// The attributes of every vertex as columns indexed by vertex ID. The name
+  /// of vertex i is names[nameOffsets[i]] to names[nameOffsets[i+1]-1], and
+  /// AST types and directions are VertexAstType and VertexDirection values.
+  struct VertexTable {
+    std::vector<uint8_t> astTypes;
+    std::vector<uint8_t> directions;
+    std::vector<uint32_t> widths;
+    std::vector<uint64_t> nameOffsets;
+    std::string names;
+  };
+
+  static PathArrays createPathArrays(const std::vector<VertexIDVec> &paths);
+
+  VertexTable getVertexTable() const;
+
+  /// Return a vertex by ID, such as from a path array.
+  Vertex *getVertex(VertexID vertex) const {
+    if (vertex >= netlist.numVertices()) {
+      throw Exception("vertex ID out of range: "+std::to_string(vertex));
+    }
+    return netlist.getVertexPtr(vertex);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Fan out and fan in degrees.
+  //===--------------------------------------------------------------------===//
+
+  /// Return the number of finish points reachable from a start point.
+  std::size_t getFanOutDegree(const std::string &startName) const {
+    auto startVertex = netlist.getStartVertex(startName);
+    if (startVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find start vertex "+startName));
+    }
+    return netlist.getfanOutDegree(startVertex);
+  }
+
+  /// Return the number of start points that reach a finish point.
+  std::size_t getFanInDegree(const std::string &finishName) const {
+    auto finishVertex = netlist.getEndVertex(finishName);
+    if (finishVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find finish vertex "+finishName));
+    }
+    return netlist.getFanInDegree(finishVertex);
+  }
+
+  /// Return the fan out degree of every start point.
+  std::vector<std::pair<Vertex*, std::size_t> > getAllFanOutDegrees() const {
+    return createVertexPtrCountVec(netlist.getAllFanOutDegrees());
+  }
+
+  /// Return the fan in degree of every finish point.
+  std::vector<std::pair<Vertex*, std::size_t> > getAllFanInDegrees() const {
+    return createVertexPtrCountVec(netlist.getAllFanInDegrees());
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Logic depth.
+  //===--------------------------------------------------------------------===//
+
+  /// Return the maximum number of logic vertices on a path from any start
+  /// point to a finish point, or -1 if there is no such path that avoids
+  /// combinational loops.
+  int getLogicDepth(const std::string &finishName) const;
+
+  /// Return the logic depth of every finish point that has one.
+  std::vector<std::pair<Vertex*, std::size_t> > getAllLogicDepths() const;
+
+  /// Return the longest path to each of the k finish points with the largest
+  /// logic depths, deepest first. Paths through combinational loops are not
+  /// considered, see getCombLoops.
+  std::vector<std::vector<Vertex*> > getDeepestPaths(std::size_t k) const;
+
+  /// Return the number of finish points with each logic depth, indexed by
+  /// depth.
+  std::vector<std::size_t> getLogicDepthHistogram() const {
+    return netlist.getLogicDepth().getHistogram();
+  }
+
+  /// Return the logic depth statistics of the finish points in each module
+  /// instance, ordered by instance name.
+  std::vector<LogicDepth::ModuleStats> getLogicDepthModuleStats() const {
+    return netlist.getLogicDepth().getModuleStats();
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Register graph.
+  //===--------------------------------------------------------------------===//
+
+  std::vector<Vertex*> getRegisterFanOut(const std::string &startName) const;
+
+  std::vector<Vertex*> getRegisterFanIn(const std::string &finishName) const;
+
+  int getPipelineDepth(const std::string &name) const;
+
+  //===--------------------------------------------------------------------===//
+  // Combinational loops.
+  //===--------------------------------------------------------------------===//
+
+  /// Return a vector of combinational loops, each given by the vertices of a
+  /// strongly-connected component of the graph containing logic.
+  std::vector<std::vector<Vertex*> > getCombLoops() const {
+    return createVertexPtrVecVec(netlist.getCombLoops());
   }
 
   //===--------------------------------------------------------------------===//
@@ -159,6 +469,55 @@ public:
     return createVertexPtrVec(getNamedVertexIds(regex));
   }
 
+  /// Return a page of the named vertices whose names start with a prefix, in
+  /// name order, for listing or completing names in chunks. The names are
+  /// sorted once, on first use.
+  std::vector<Vertex*> getNamedVerticesPage(const std::string &prefix,
+                                            std::size_t offset,
+                                            std::size_t count) const;
+
+  /// Return the number of named vertices whose names start with a prefix.
+  std::size_t getNumNamedVertices(const std::string &prefix="") const {
+    auto range = netlist.getNamePrefixRange(prefix);
+    return range.second - range.first;
+  }
+
+  /// Return the named vertices within a hierarchical scope, such as an
+  /// instance "top.core0.alu", using the name index rather than a search of
+  /// the netlist.
+  std::vector<Vertex*> getVerticesInScope(const std::string &scope) const {
+    VertexIDVec vertices;
+    for (auto vertex : netlist.getVerticesInScope(scope)) {
+      if (netlist.getVertex(vertex).isNamed()) {
+        vertices.push_back(vertex);
+      }
+    }
+    return createVertexPtrVec(vertices);
+  }
+
+  /// Return the names of the instances directly within a scope.
+  std::vector<std::string> getChildScopes(const std::string &scope) const {
+    return netlist.getChildScopes(scope);
+  }
+
+  /// Return the registers within a hierarchical scope.
+  std::vector<Vertex*> getRegistersInScope(const std::string &scope) const {
+    VertexIDVec vertices;
+    for (auto vertex : netlist.getVerticesInScope(scope)) {
+      if (netlist.getVertex(vertex).isDstReg()) {
+        vertices.push_back(vertex);
+      }
+    }
+    return createVertexPtrVec(vertices);
+  }
+
+  /// Return a path from each point within a hierarchical scope to each point
+  /// outside it that it drives through combinational logic.
+  std::vector<std::vector<Vertex*> >
+  getPathsLeavingScope(const std::string &scope) const {
+    return createVertexPtrVecVec(netlist.getPathsLeavingScope(scope));
+  }
+
   void dumpDotFile(const std::string &outputFilename) const {
     netlist.dumpDotFile(outputFilename);
   }
@@ -1,6 +1,8 @@
 #ifndef NETLIST_PATHS_OPTIONS_HPP
 #define NETLIST_PATHS_OPTIONS_HPP
 
+#include <atomic>
+
 namespace netlist_paths {
 
 constexpr const char *DEFAULT_OUTPUT_FILENAME = "netlist";
@@ -14,18 +16,25 @@ struct Options {
   bool allPaths;
   bool startPoints;
   bool endPoints;
-  bool fanOutDegree;
-  bool fanInDegree;
   bool reportLogic;
   bool fullFileNames;
   bool compile;
   bool boostParser;
   bool matchWildcard;
+  unsigned numThreads;
+  unsigned long bfsThreshold;
+  unsigned long traversalCacheSize;
+  /// Incremented by each change to a setting copied into query contexts.
+  std::atomic<unsigned> generation;
   bool getMatchWildcard() const { return matchWildcard; }
-  void setMatchWildcard() { matchWildcard = true; }
-  void setMatchRegex() { matchWildcard = false; }
-  void setVerbose() { verboseMode = true; }
-  void setDebug() { debugMode = true; }
+  void setMatchWildcard() { matchWildcard = true; ++generation; }
+  void setMatchRegex() { matchWildcard = false; ++generation; }
+  void setVerbose() { verboseMode = true; ++generation; }
+  void setDebug() { debugMode = true; ++generation; }
+  void setNumThreads(unsigned value) { numThreads = value; ++generation; }
+  void setBFSThreshold(unsigned long value) { bfsThreshold = value; ++generation; }
+  void setTraversalCacheSize(unsigned long value) { traversalCacheSize = value; ++generation; }
+  unsigned getGeneration() const { return generation; }
 public:
   // Singleton instance.
   static Options &getInstance() {
@@ -45,13 +54,15 @@ private:
       allPaths(false),
       startPoints(false),
       endPoints(false),
-      fanOutDegree(false),
-      fanInDegree(false),
       reportLogic(false),
       fullFileNames(false),
       compile(false),
       boostParser(false),
-      matchWildcard(true) {}
+      matchWildcard(true),
+      numThreads(0),
+      bfsThreshold(100000),
+      traversalCacheSize(64UL << 20),
+      generation(0) {}
 public:
   // Prevent copies from being made (C++11).
   Options(Options const&) = delete;
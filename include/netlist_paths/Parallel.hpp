@@ -0,0 +1,177 @@
+#ifndef NETLIST_PATHS_PARALLEL_HPP
+#define NETLIST_PATHS_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "netlist_paths/QueryContext.hpp"
+
+namespace netlist_paths {
+
+/// A set of threads kept for the life of the process to run the tasks of
+/// parallel operations, so each operation does not create its own threads.
+/// The threads are created as they are first needed.
+class ThreadPool {
+  struct Job {
+    const std::function<void(unsigned)> *task;
+    unsigned next;
+    unsigned end;
+    unsigned running;
+    std::condition_variable finished;
+  };
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<Job*> jobs;
+  std::vector<std::thread> threads;
+  bool stopping;
+
+  ThreadPool() : stopping(false) {}
+  void work();
+
+public:
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool &operator=(const ThreadPool&) = delete;
+
+  /// Call task(0) on the calling thread and task(i) for i in [1, numTasks) on
+  /// the threads of the pool, returning once they have finished. Tasks not
+  /// started by a pool thread by the time task(0) returns are not run, so a
+  /// task can itself run tasks on the pool without waiting for threads that
+  /// are all busy, and task(0) must be able to complete the work of any task
+  /// that is not run. The task must not throw.
+  void run(unsigned numTasks, const std::function<void(unsigned)> &task);
+
+  // Singleton instance.
+  static ThreadPool &getInstance() {
+    static ThreadPool instance;
+    return instance;
+  }
+};
+
+/// Return the number of threads to use for parallel operations.
+inline unsigned getNumThreads() {
+  auto numThreads = QueryContext::current().numThreads;
+  if (numThreads == 0) {
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return numThreads;
+}
+
+/// Call fn(index, threadIndex) for each index in [0, size), distributing the
+/// indexes over the calling thread and up to numThreads - 1 threads of the
+/// thread pool by work stealing. Each thread starts with an equal contiguous
+/// range of indexes and takes them from the front of its range; once its
+/// range is empty it steals the back half of the largest remaining range of
+/// another thread, including the ranges of pool threads that have not
+/// started. The first exception thrown by fn is rethrown once all threads
+/// have finished. The other threads make queries with the settings of the
+/// calling thread's query context.
+template<typename Fn>
+void parallelFor(std::size_t size, unsigned maxThreads, Fn fn) {
+  auto numThreads = std::min<std::size_t>(maxThreads, size);
+  if (numThreads <= 1) {
+    for (std::size_t i = 0; i < size; ++i) {
+      fn(i, 0);
+    }
+    return;
+  }
+  struct Range {
+    std::mutex mutex;
+    std::size_t begin;
+    std::size_t end;
+  };
+  std::vector<Range> ranges(numThreads);
+  for (std::size_t t = 0; t < numThreads; ++t) {
+    ranges[t].begin = (size * t) / numThreads;
+    ranges[t].end = (size * (t + 1)) / numThreads;
+  }
+  std::atomic<bool> cancelled(false);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  // Take the next index from a thread's own range.
+  auto next = [&](unsigned threadIndex, std::size_t &index) {
+    auto &range = ranges[threadIndex];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin == range.end) {
+      return false;
+    }
+    index = range.begin++;
+    return true;
+  };
+  // Move the back half of the largest other range to a thread's own range.
+  auto steal = [&](unsigned threadIndex) {
+    while (true) {
+      std::size_t victim = numThreads;
+      std::size_t victimSize = 0;
+      for (std::size_t t = 0; t < numThreads; ++t) {
+        if (t != threadIndex) {
+          std::lock_guard<std::mutex> lock(ranges[t].mutex);
+          if (ranges[t].end - ranges[t].begin > victimSize) {
+            victim = t;
+            victimSize = ranges[t].end - ranges[t].begin;
+          }
+        }
+      }
+      if (victim == numThreads) {
+        return false;
+      }
+      std::size_t begin, end;
+      {
+        std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+        auto &range = ranges[victim];
+        if (range.begin == range.end) {
+          continue;
+        }
+        end = range.end;
+        begin = range.end - (range.end - range.begin + 1) / 2;
+        range.end = begin;
+      }
+      std::lock_guard<std::mutex> lock(ranges[threadIndex].mutex);
+      ranges[threadIndex].begin = begin;
+      ranges[threadIndex].end = end;
+      return true;
+    }
+  };
+  auto &context = QueryContext::current();
+  auto worker = [&](unsigned threadIndex) {
+    try {
+      QueryContext workerContext(context);
+      QueryScope scope(workerContext);
+      std::size_t index;
+      while (!cancelled) {
+        if (next(threadIndex, index)) {
+          fn(index, threadIndex);
+        } else if (!steal(threadIndex)) {
+          break;
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (!exception) {
+        exception = std::current_exception();
+      }
+      cancelled = true;
+    }
+  };
+  ThreadPool::getInstance().run(numThreads, worker);
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/// Call fn(index, threadIndex) for each index in [0, size), using the
+/// configured number of threads.
+template<typename Fn>
+void parallelFor(std::size_t size, Fn fn) {
+  parallelFor(size, getNumThreads(), fn);
+}
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_PARALLEL_HPP
@@ -0,0 +1,67 @@
+#ifndef NETLIST_PATHS_PATH_ENUMERATOR_HPP
+#define NETLIST_PATHS_PATH_ENUMERATOR_HPP
+
+#include <memory>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+class TraversalTree;
+
+/// Produces the paths of a query one at a time, in the same order as the
+/// query that returns them all, so that a consumer sees the first path as
+/// soon as it is found, can stop early, and does not hold the whole result.
+class PathEnumerator {
+public:
+  virtual ~PathEnumerator() {}
+  /// Set path to the next path and return true, or return false if there
+  /// are no more paths.
+  virtual bool next(VertexIDVec &path) = 0;
+};
+
+/// Enumerates no paths, for queries that cannot have any.
+class EmptyPathEnumerator : public PathEnumerator {
+public:
+  bool next(VertexIDVec&) override { return false; }
+};
+
+/// Enumerates the path to each finish point reached by a traversal from a
+/// start point, or from each start point reaching a finish point if the
+/// traversal is reversed, ordered by vertex.
+class FanPathEnumerator : public PathEnumerator {
+  const Graph &graph;
+  std::shared_ptr<const TraversalTree> tree;
+  std::vector<VertexIDPair>::const_iterator position;
+
+public:
+  FanPathEnumerator(const Graph &graph,
+                    std::shared_ptr<const TraversalTree> tree);
+  bool next(VertexIDVec &path) override;
+};
+
+/// Enumerates all the simple paths between a start and a finish point, given
+/// the parents of each vertex from a search from the start point. The paths
+/// are found by a search backwards from the finish point, which is held as an
+/// explicit stack so that it can be resumed between paths. The number of
+/// paths can grow exponentially with the size of the graph.
+class AllPathsEnumerator : public PathEnumerator {
+  ParentMap parentMap;
+  VertexID startVertex;
+  VertexID finishVertex;
+  bool started;
+  /// The current path, from the finish point backwards, and the index of the
+  /// next parent to visit of each vertex on it.
+  VertexIDVec stack;
+  std::vector<std::size_t> indexes;
+
+public:
+  AllPathsEnumerator(ParentMap parentMap,
+                     VertexID startVertex,
+                     VertexID finishVertex);
+  bool next(VertexIDVec &path) override;
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_PATH_ENUMERATOR_HPP
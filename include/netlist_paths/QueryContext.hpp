@@ -0,0 +1,67 @@
+#ifndef NETLIST_PATHS_QUERY_CONTEXT_HPP
+#define NETLIST_PATHS_QUERY_CONTEXT_HPP
+
+#include "netlist_paths/Graph.hpp"
+#include "netlist_paths/Options.hpp"
+
+namespace netlist_paths {
+
+/// The settings and working buffers of the queries made by a thread. A
+/// context is entered on a thread for the duration of some queries, and the
+/// queries use the most recently entered context of their thread, or else a
+/// per-thread default that follows the global Options. Different threads can
+/// therefore make differently configured queries of one netlist at the same
+/// time. A context must only be entered on one thread at a time, since its
+/// buffers are reused by each query without locking. Copying a context copies
+/// its settings but not its buffers.
+class QueryContext {
+public:
+  bool debugMode;
+  bool verboseMode;
+  bool matchWildcard;
+  unsigned numThreads;
+  unsigned long bfsThreshold;
+  unsigned long traversalCacheSize;
+  /// Reused by the traversals of successive queries.
+  TraversalScratch scratch;
+
+  /// Create a context with the settings of the global options.
+  QueryContext();
+  QueryContext(const QueryContext &other);
+  QueryContext &operator=(const QueryContext &other);
+
+  bool getMatchWildcard() const { return matchWildcard; }
+  void setMatchWildcard() { matchWildcard = true; }
+  void setMatchRegex() { matchWildcard = false; }
+  void setVerbose() { verboseMode = true; }
+  void setDebug() { debugMode = true; }
+  void setNumThreads(unsigned value) { numThreads = value; }
+  void setBFSThreshold(unsigned long value) { bfsThreshold = value; }
+  void setTraversalCacheSize(unsigned long value) { traversalCacheSize = value; }
+
+  /// Make this the context of the calling thread until the matching exit.
+  /// Contexts can be nested.
+  void enter();
+  /// Restore the context the calling thread had before the matching enter.
+  void exit();
+
+  /// Return the context of the calling thread.
+  static QueryContext &current();
+};
+
+/// Enter a context on the calling thread for the lifetime of the scope.
+class QueryScope {
+  QueryContext &context;
+
+public:
+  explicit QueryScope(QueryContext &context) : context(context) {
+    context.enter();
+  }
+  ~QueryScope() { context.exit(); }
+  QueryScope(const QueryScope&) = delete;
+  QueryScope &operator=(const QueryScope&) = delete;
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_QUERY_CONTEXT_HPP
@@ -0,0 +1,66 @@
+#ifndef NETLIST_PATHS_REACHABILITY_INDEX_HPP
+#define NETLIST_PATHS_REACHABILITY_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+/// An index over the strongly-connected components of a graph (see
+/// Condensation), used to answer reachability queries without searching the
+/// netlist graph. Components are numbered in topological order, so a
+/// component can only reach components with a greater or equal number. For
+/// small graphs the transitive closure of the condensed graph is stored as a
+/// bitset per component, giving exact answers directly. For larger graphs,
+/// each component is labelled with a set of intervals from randomised
+/// post-order traversals (GRAIL), which answer most negative queries directly
+/// and prune the search of the condensed graph otherwise.
+class ReachabilityIndex {
+  /// The maximum number of components to compute a full closure for.
+  static constexpr std::size_t MAX_CLOSURE_COMPONENTS = 8192;
+  /// The number of interval labels per component.
+  static constexpr std::size_t NUM_LABELS = 3;
+
+  using Label = std::pair<uint32_t, uint32_t>;
+
+  /// Size and edge hash of the graph the index was built for.
+  uint64_t numVertices;
+  uint64_t numEdges;
+  uint64_t edgeHash;
+  uint64_t numComponents;
+  /// Topologically-ordered component of each vertex.
+  std::vector<uint32_t> components;
+  /// Condensed graph in compressed sparse row form.
+  std::vector<uint64_t> dagOffsets;
+  std::vector<uint32_t> dagEdges;
+  /// Per-component closure bitsets, used when the graph is small enough.
+  std::vector<uint64_t> closure;
+  /// Per-component interval labels, NUM_LABELS for each component.
+  std::vector<Label> labels;
+
+  static uint64_t hashEdges(const Graph &graph);
+  std::size_t closureWords() const { return (numComponents + 63) / 64; }
+  void buildClosure();
+  void buildLabels();
+  bool labelsContain(uint32_t src, uint32_t dst) const;
+  bool searchDAG(uint32_t src, uint32_t dst) const;
+  bool isConsistent() const;
+
+public:
+  ReachabilityIndex() = delete;
+  /// Build an index for a graph.
+  ReachabilityIndex(const Graph &graph);
+  /// Load an index for a graph from a file.
+  ReachabilityIndex(const Graph &graph, const std::string &filename);
+  void save(const std::string &filename) const;
+  bool reachable(VertexID startVertex, VertexID finishVertex) const;
+  std::size_t getNumComponents() const { return numComponents; }
+  bool hasClosure() const { return !closure.empty(); }
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_REACHABILITY_INDEX_HPP
@@ -0,0 +1,69 @@
+#ifndef NETLIST_PATHS_REGISTER_GRAPH_HPP
+#define NETLIST_PATHS_REGISTER_GRAPH_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+/// A graph derived from the netlist whose nodes are registers and top-level
+/// ports, with an edge from one node to another when a combinational path
+/// exists between them. The source and destination vertices of a register
+/// are combined into a single node. Edges are stored in compressed sparse row
+/// form in both directions.
+class RegisterGraph {
+public:
+  using NodeID = uint32_t;
+  static constexpr NodeID NULL_NODE = UINT32_MAX;
+
+  struct Node {
+    /// The vertex paths start from (a source register or input port).
+    VertexID startVertex;
+    /// The vertex paths finish at (a destination register or output port).
+    VertexID finishVertex;
+  };
+
+private:
+  const Graph &graph;
+  std::vector<Node> nodes;
+  std::unordered_map<VertexID, NodeID> vertexNodes;
+  std::vector<uint64_t> fanOutOffsets;
+  std::vector<NodeID> fanOutEdges;
+  std::vector<uint64_t> fanInOffsets;
+  std::vector<NodeID> fanInEdges;
+  std::vector<int> pipelineDepths;
+
+  void determineNodes();
+  void determineEdges();
+  void determinePipelineDepths();
+
+public:
+  RegisterGraph() = delete;
+  RegisterGraph(const Graph &graph);
+  std::size_t numNodes() const { return nodes.size(); }
+  std::size_t numEdges() const { return fanOutEdges.size(); }
+  const Node &getNode(NodeID node) const { return nodes[node]; }
+  /// Return the node of a start or finish vertex, or NULL_NODE.
+  NodeID getNode(VertexID vertex) const {
+    auto it = vertexNodes.find(vertex);
+    return it != vertexNodes.end() ? it->second : NULL_NODE;
+  }
+  std::vector<NodeID> getFanOut(NodeID node) const {
+    return std::vector<NodeID>(fanOutEdges.begin() + fanOutOffsets[node],
+                               fanOutEdges.begin() + fanOutOffsets[node + 1]);
+  }
+  std::vector<NodeID> getFanIn(NodeID node) const {
+    return std::vector<NodeID>(fanInEdges.begin() + fanInOffsets[node],
+                               fanInEdges.begin() + fanInOffsets[node + 1]);
+  }
+  /// Return the minimum number of registers on a path from any input port to
+  /// each node, or -1 where there is no such path.
+  const std::vector<int> &getPipelineDepths() const { return pipelineDepths; }
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_REGISTER_GRAPH_HPP
@@ -0,0 +1,80 @@
+#ifndef NETLIST_PATHS_TRAVERSAL_CACHE_HPP
+#define NETLIST_PATHS_TRAVERSAL_CACHE_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "netlist_paths/Graph.hpp"
+
+namespace netlist_paths {
+
+/// The result of a traversal from a root vertex: the vertices it reached,
+/// each with its parent in the traversal tree, ordered by vertex.
+class TraversalTree {
+  VertexID root;
+  bool reverse;
+  bool depthFirst;
+  std::vector<VertexIDPair> parents;
+
+public:
+  TraversalTree() = delete;
+  /// Copy the vertices reached by the last traversal from a scratch.
+  TraversalTree(VertexID root, bool reverse, bool depthFirst,
+                const TraversalScratch &scratch);
+  VertexID getRoot() const { return root; }
+  bool isReverse() const { return reverse; }
+  /// Whether the tree was produced by a complete depth-first traversal.
+  bool isDepthFirst() const { return depthFirst; }
+  std::size_t size() const { return parents.size(); }
+  bool isReached(VertexID vertex) const;
+  VertexID getParent(VertexID vertex) const;
+  /// Iterate the reached vertices and their parents, in vertex order.
+  std::vector<VertexIDPair>::const_iterator begin() const { return parents.begin(); }
+  std::vector<VertexIDPair>::const_iterator end() const { return parents.end(); }
+  /// Return the approximate number of bytes used by the tree.
+  std::size_t memoryUsage() const {
+    return sizeof(TraversalTree) + parents.capacity() * sizeof(VertexIDPair);
+  }
+};
+
+/// A cache of traversal trees keyed by root vertex and direction, evicting
+/// the least-recently-used trees once their total size exceeds a capacity in
+/// bytes. It can be used by several threads at once.
+class TraversalCache {
+  using Key = std::pair<VertexID, bool>;
+  using Entry = std::pair<Key, std::shared_ptr<const TraversalTree>>;
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const {
+      return std::hash<VertexID>()(key.first) * 2 + key.second;
+    }
+  };
+
+  mutable std::mutex mutex;
+  /// Entries ordered from most to least recently used.
+  std::list<Entry> entries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+  std::size_t numBytes = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+
+  void evict(std::size_t capacity);
+
+public:
+  /// Return the cached tree for a root and direction, or null.
+  std::shared_ptr<const TraversalTree> lookup(VertexID root, bool reverse);
+  /// Add a tree, replacing any for the same root and direction, then evict
+  /// trees until the cache fits the capacity. A tree larger than the capacity
+  /// is not added.
+  void insert(std::shared_ptr<const TraversalTree> tree, std::size_t capacity);
+  void clear();
+  TraversalCacheStats getStats() const;
+};
+
+} // End namespace.
+
+#endif // NETLIST_PATHS_TRAVERSAL_CACHE_HPP
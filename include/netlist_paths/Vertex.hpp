@@ -169,7 +169,7 @@ public:
       isParam(isParam),
       paramValue(paramValue),
       isPublic(isPublic),
-      isTop(determineIsTop(name)),
+      isTop(false),
       deleted(false) {}
 
   /// Copy constructor.
@@ -180,23 +180,16 @@ public:
       dtype(v.dtype),
       name(v.name),
       isParam(v.isParam),
+      paramValue(v.paramValue),
+      isPublic(v.isPublic),
       isTop(v.isTop),
       deleted(v.deleted) {}
 
   /// A Vertex is in the 'top' scope when has one or two hierarchical components.
-  /// module.name or name is top level, but module.submodule.name is not.
-  static bool determineIsTop(const std::string &name) {
-    std::vector<std::string> tokens;
-    boost::split(tokens, name, boost::is_any_of("."));
-    return tokens.size() < 3;
-  }
-
-  /// Given a hierarchical name a.b.c, return the last component c.
-  std::string getBasename() const {
-    std::vector<std::string> tokens;
-    boost::split(tokens, name, boost::is_any_of("."));
-    return tokens.back();
-  }
+  /// module.name or name is top level, but module.submodule.name is not. This
+  /// is determined from the instance hierarchy when the vertex is added to a
+  /// graph, see Graph::isTop and Graph::getBasename.
+  void setTop(bool value) { isTop = value; }
 
   /// Less than comparison
   bool compareLessThan(const Vertex &b) const {
@@ -328,7 +321,7 @@ public:
   VertexDirection getDirection() const { return direction; }
   size_t getDTypeWidth() const { return dtype != nullptr ? dtype->getWidth() : 0; }
   bool getIsPublic() const { return isPublic; }
-  const std::string getName() const { return name; }
+  const std::string &getName() const { return name; }
   const std::string getAstTypeStr() const { return getVertexAstTypeStr(astType); }
   const std::string getDirStr() const { return getVertexDirectionStr(direction); }
   const std::string getDTypeStr() const { return dtype != nullptr ? dtype->toString() : "none"; }
@@ -8,6 +8,7 @@ namespace netlist_paths {
 
 class Waypoints {
   std::vector<std::string> waypoints;
+  std::vector<std::string> avoidPoints;
   bool got_start_point;
   bool got_finish_point;
 
@@ -53,6 +54,13 @@ public:
     }
   }
 
+  /// Add a name or pattern of vertices that paths must not pass through.
+  /// Every vertex matching the pattern is avoided.
+  void addAvoidPoint(const std::string name) {
+    avoidPoints.push_back(name);
+  }
+
+  const std::vector<std::string> &getAvoidPoints() const { return avoidPoints; }
   std::vector<std::string>::iterator begin() { return waypoints.begin(); }
   std::vector<std::string>::iterator end() { return waypoints.end(); }
   bool empty() const { return waypoints.empty(); }
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <boost/graph/iteration_macros.hpp>
+#include "netlist_paths/Condensation.hpp"
+#include "netlist_paths/Debug.hpp"
+#include "netlist_paths/Options.hpp"
+
+using namespace netlist_paths;
+
+Condensation::Condensation(const Graph &graph) {
+  INFO(std::cout << "Determining strongly-connected components\n");
+  determineComponents(graph.graph);
+  determineMembers();
+  determineEdges(graph.graph);
+  determineLoops(graph.graph);
+  INFO(std::cout << "Graph contains " << getNumComponents()
+                 << " strongly-connected components and "
+                 << loops.size() << " combinational loops\n");
+}
+
+/// Tarjan's algorithm, with the recursion replaced by an explicit stack of
+/// vertices and their next out edge. Components are completed in reverse
+/// topological order, so they are numbered from the last.
+void Condensation::determineComponents(const InternalGraph &graph) {
+  using OutEdgeIterator = boost::graph_traits<InternalGraph>::out_edge_iterator;
+  struct Frame {
+    VertexID vertex;
+    OutEdgeIterator next;
+    OutEdgeIterator end;
+  };
+  constexpr uint32_t UNVISITED = std::numeric_limits<uint32_t>::max();
+  auto numVertices = boost::num_vertices(graph);
+  std::vector<uint32_t> indexes(numVertices, UNVISITED);
+  std::vector<uint32_t> lowLinks(numVertices);
+  std::vector<bool> onStack(numVertices, false);
+  std::vector<VertexID> stack;
+  std::vector<Frame> callStack;
+  std::vector<uint32_t> completed(numVertices);
+  uint32_t index = 0;
+  uint32_t numComponents = 0;
+  auto visit = [&](VertexID vertex) {
+    indexes[vertex] = lowLinks[vertex] = index++;
+    stack.push_back(vertex);
+    onStack[vertex] = true;
+    auto outEdges = boost::out_edges(vertex, graph);
+    callStack.push_back({vertex, outEdges.first, outEdges.second});
+  };
+  for (VertexID root = 0; root < numVertices; ++root) {
+    if (indexes[root] != UNVISITED) {
+      continue;
+    }
+    visit(root);
+    while (!callStack.empty()) {
+      auto &frame = callStack.back();
+      auto vertex = frame.vertex;
+      if (frame.next != frame.end) {
+        auto adjVertex = boost::target(*frame.next++, graph);
+        if (indexes[adjVertex] == UNVISITED) {
+          visit(adjVertex);
+        } else if (onStack[adjVertex]) {
+          lowLinks[vertex] = std::min(lowLinks[vertex], indexes[adjVertex]);
+        }
+        continue;
+      }
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        auto parent = callStack.back().vertex;
+        lowLinks[parent] = std::min(lowLinks[parent], lowLinks[vertex]);
+      }
+      if (lowLinks[vertex] == indexes[vertex]) {
+        // Vertex is the root of a component.
+        VertexID member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          onStack[member] = false;
+          completed[member] = numComponents;
+        } while (member != vertex);
+        numComponents++;
+      }
+    }
+  }
+  components.resize(numVertices);
+  for (std::size_t v = 0; v < numVertices; ++v) {
+    components[v] = numComponents - 1 - completed[v];
+  }
+  memberOffsets.assign(numComponents + 1, 0);
+}
+
+/// Group the vertices by component with a counting sort.
+void Condensation::determineMembers() {
+  for (auto component : components) {
+    memberOffsets[component + 1]++;
+  }
+  std::partial_sum(std::begin(memberOffsets), std::end(memberOffsets),
+                   std::begin(memberOffsets));
+  members.resize(components.size());
+  std::vector<uint64_t> next(std::begin(memberOffsets),
+                             std::end(memberOffsets) - 1);
+  for (VertexID v = 0; v < components.size(); ++v) {
+    members[next[components[v]]++] = v;
+  }
+}
+
+/// Construct the condensed graph, removing duplicate edges.
+void Condensation::determineEdges(const InternalGraph &graph) {
+  auto numComponents = getNumComponents();
+  std::vector<uint64_t> offsets(numComponents + 1, 0);
+  BGL_FORALL_EDGES(e, graph, InternalGraph) {
+    auto src = components[boost::source(e, graph)];
+    auto dst = components[boost::target(e, graph)];
+    if (src != dst) {
+      offsets[src + 1]++;
+    }
+  }
+  std::partial_sum(std::begin(offsets), std::end(offsets), std::begin(offsets));
+  std::vector<uint32_t> targets(offsets.back());
+  std::vector<uint64_t> next(std::begin(offsets), std::end(offsets) - 1);
+  BGL_FORALL_EDGES(e, graph, InternalGraph) {
+    auto src = components[boost::source(e, graph)];
+    auto dst = components[boost::target(e, graph)];
+    if (src != dst) {
+      targets[next[src]++] = dst;
+    }
+  }
+  dagOffsets.push_back(0);
+  for (std::size_t c = 0; c < numComponents; ++c) {
+    auto begin = std::begin(targets) + offsets[c];
+    auto end = std::begin(targets) + offsets[c + 1];
+    std::sort(begin, end);
+    dagEdges.insert(std::end(dagEdges), begin, std::unique(begin, end));
+    dagOffsets.push_back(dagEdges.size());
+  }
+}
+
+/// A component is a combinational loop if it contains a logic vertex and
+/// more than one vertex, or a logic vertex with an edge to itself. Components
+/// that contain only variables are formed by the edges between ports and
+/// their aliases and are not loops.
+void Condensation::determineLoops(const InternalGraph &graph) {
+  for (uint32_t c = 0; c < getNumComponents(); ++c) {
+    auto begin = membersBegin(c);
+    auto end = membersEnd(c);
+    auto isLogic = [&graph](VertexID v) { return graph[v].isLogic(); };
+    if (std::none_of(begin, end, isLogic)) {
+      continue;
+    }
+    if (getNumMembers(c) > 1 || boost::edge(*begin, *begin, graph).second) {
+      loops.push_back(c);
+    }
+  }
+}
@@ -1,58 +1,60 @@
 #include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
-#include <regex>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/iteration_macros.hpp>
 #include <boost/graph/reverse_graph.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
+#include "netlist_paths/Condensation.hpp"
 #include "netlist_paths/Debug.hpp"
 #include "netlist_paths/Exception.hpp"
 #include "netlist_paths/Graph.hpp"
+#include "netlist_paths/LogicDepth.hpp"
+#include "netlist_paths/NameIndex.hpp"
+#include "netlist_paths/NameMatcher.hpp"
 #include "netlist_paths/Options.hpp"
+#include "netlist_paths/Parallel.hpp"
+#include "netlist_paths/PathEnumerator.hpp"
+#include "netlist_paths/QueryContext.hpp"
+#include "netlist_paths/RegisterGraph.hpp"
+#include "netlist_paths/TraversalCache.hpp"
 
 using namespace netlist_paths;
 
-class DfsVisitor : public boost::default_dfs_visitor {
-private:
-  ParentMap &parentMap;
-  bool allPaths;
-public:
-  DfsVisitor(ParentMap &parentMap, bool allPaths) :
-      parentMap(parentMap), allPaths(allPaths) {}
-  // Visit only the edges of the DFS graph.
-  template<typename Edge, typename Graph>
-  void tree_edge(Edge edge, const Graph &graph) const {
-    if (!allPaths) {
-      VertexID src, dst;
-      src = boost::source(edge, graph);
-      dst = boost::target(edge, graph);
-      parentMap[dst].push_back(src);
-    }
-    return;
-  }
-  // Visit all edges of a vertex.
-  template<typename Edge, typename Graph>
-  void examine_edge(Edge edge, const Graph &graph) const {
-    if (allPaths) {
-      VertexID src, dst;
-      src = boost::source(edge, graph);
-      dst = boost::target(edge, graph);
-      parentMap[dst].push_back(src);
-    }
-    return;
-  }
-};
+/// The number of start points whose reachability is propagated together.
+static const std::size_t REACHABILITY_GROUP_SIZE = 64;
+
+Graph::Graph() : nameIndex(std::make_unique<NameIndex>()) {}
+
+Graph::~Graph() {}
+
+VertexID Graph::addVarVertex(VertexAstType type,
+                             VertexDirection direction,
+                             Location location,
+                             std::shared_ptr<DType> dtype,
+                             const std::string &name,
+                             bool isParam,
+                             const std::string &paramValue,
+                             bool isPublic) {
+  auto vertex = boost::add_vertex(Vertex(type, direction, location, dtype, name,
+                                         isParam, paramValue, isPublic), graph);
+  nameIndex->insert(name, vertex);
+  graph[vertex].setTop(nameIndex->isTop(vertex));
+  return vertex;
+}
 
 /// Register vertices are split into 'destination' registers only with in edges
 /// and 'source' registers only with out edges. This implies graph connectivity
@@ -70,6 +72,7 @@ void Graph::splitRegVertices() {
       Vertex srcReg(graph[v]);
       srcReg.setSrcReg();
       auto srcRegVertex = boost::add_vertex(srcReg, graph);
+      nameIndex->insert(srcReg.getName(), srcRegVertex);
       // Move the out edges to the src reg (while not iterating).
       for (auto adjVertex : adjacentVertices) {
         boost::remove_edge(v, adjVertex, graph);
@@ -172,43 +175,212 @@ void Graph::dumpDotFile(const std::string &outputFilename) const {
 
 /// Lookup a vertex by name.
 VertexID Graph::getVertexDesc(const std::string &name) const {
+  return nameIndex->lookup(name);
+}
+
+/// Return the vertices with names within a hierarchical scope, such as an
+/// instance, ordered by vertex.
+VertexIDVec Graph::getVerticesInScope(const std::string &scope) const {
+  return nameIndex->getVerticesInScope(scope);
+}
+
+/// Return the names of the instance scopes directly within a scope.
+std::vector<std::string> Graph::getChildScopes(const std::string &scope) const {
+  return nameIndex->getChildScopes(scope);
+}
+
+/// Return a path from each vertex named within a hierarchical scope to each
+/// named vertex outside it that it drives through logic alone. These are the
+/// paths leaving the instance, ordered by the vertex inside it.
+std::vector<VertexIDVec>
+Graph::getPathsLeavingScope(const std::string &scope) const {
+  std::vector<VertexIDVec> paths;
+  auto scopeNode = nameIndex->findScope(scope);
+  if (scopeNode == NameIndex::NULL_NODE) {
+    return paths;
+  }
+  std::vector<VertexID> parents(numVertices(), nullVertex());
+  std::vector<VertexID> visited;
+  std::deque<VertexID> worklist;
+  for (auto vertex : nameIndex->getVerticesInScope(scope)) {
+    // Search forwards through the logic driven by the vertex, stopping at
+    // named vertices.
+    parents[vertex] = vertex;
+    visited.push_back(vertex);
+    worklist.push_back(vertex);
+    while (!worklist.empty()) {
+      auto current = worklist.front();
+      worklist.pop_front();
+      BGL_FORALL_OUTEDGES(current, e, graph, InternalGraph) {
+        auto target = boost::target(e, graph);
+        if (parents[target] != nullVertex()) {
+          continue;
+        }
+        parents[target] = current;
+        visited.push_back(target);
+        if (graph[target].isLogic()) {
+          worklist.push_back(target);
+        } else if (!nameIndex->isWithin(target, scopeNode)) {
+          VertexIDVec path;
+          for (auto v = target; v != vertex; v = parents[v]) {
+            path.push_back(v);
+          }
+          path.push_back(vertex);
+          std::reverse(std::begin(path), std::end(path));
+          paths.push_back(std::move(path));
+        }
+      }
+    }
+    for (auto v : visited) {
+      parents[v] = nullVertex();
+    }
+    visited.clear();
+  }
+  return paths;
+}
+
+/// Return the named vertices in name order, sorting them on first use. The
+/// graph must not be modified after this.
+const NameOrder &Graph::getNameOrder() const {
+  std::lock_guard<std::mutex> lock(nameOrderMutex);
+  if (!nameOrder) {
+    auto order = std::make_shared<NameOrder>();
+    for (auto v : nameIndex->getVertices()) {
+      if (graph[v].isNamed()) {
+        order->vertices.push_back(v);
+      }
+    }
+    std::sort(std::begin(order->vertices), std::end(order->vertices),
+              [this](VertexID a, VertexID b) {
+                return graph[a].compareLessThan(graph[b]); });
+    order->positions.assign(numVertices(), 0);
+    for (std::size_t i = 0; i < order->vertices.size(); ++i) {
+      order->positions[order->vertices[i]] = i;
+    }
+    INFO(std::cout << "Sorted " << order->vertices.size() << " names\n");
+    nameOrder = order;
+  }
+  return *nameOrder;
+}
+
+/// Sort a set of named vertices into name order, by their positions in the
+/// name order rather than by comparing names.
+void Graph::sortByName(VertexIDVec &vertices) const {
+  auto &order = getNameOrder();
+  std::sort(std::begin(vertices), std::end(vertices),
+            [&order](VertexID a, VertexID b) {
+              return order.positions[a] < order.positions[b]; });
+}
+
+/// Return the range of positions in the name order of the named vertices
+/// whose names start with a prefix.
+std::pair<std::size_t, std::size_t>
+Graph::getNamePrefixRange(const std::string &prefix) const {
+  auto &order = getNameOrder();
+  auto begin = std::lower_bound(std::begin(order.vertices),
+                                std::end(order.vertices), prefix,
+                                [this](VertexID v, const std::string &value) {
+                                  return graph[v].getName() < value; });
+  auto end = std::upper_bound(begin, std::end(order.vertices), prefix,
+                              [this](const std::string &value, VertexID v) {
+                                return graph[v].getName().compare(
+                                    0, value.size(), value) > 0; });
+  return std::make_pair(std::distance(std::begin(order.vertices), begin),
+                        std::distance(std::begin(order.vertices), end));
+}
+
+/// Return true if a vertex is in the top scope, from the instance hierarchy,
+/// or false if it has no name.
+bool Graph::isTop(VertexID vertex) const {
+  return nameIndex->isTop(vertex);
+}
+
+/// Given a vertex with a hierarchical name a.b.c, return the last component
+/// c, from the instance hierarchy, or an empty string if it has no name.
+const std::string &Graph::getBasename(VertexID vertex) const {
+  return nameIndex->getBasename(vertex);
+}
+
+/// Create a matcher for a name pattern, ignoring hierarchy separators and,
+/// in wildcard mode, converting wildcards.
+static NameMatcher createNameMatcher(const std::string &name) {
+  return NameMatcher(name, QueryContext::current().getMatchWildcard(), true);
+}
+
+/// Call fn(vertex) for each vertex whose name matches, in order, until it
+/// returns false. If the pattern has a required literal, only the vertices
+/// whose names contain it, found by a substring search of the name index,
+/// are matched against the full pattern. Otherwise, unless the pattern
+/// matches the empty names of logic vertices, only the named vertices are.
+void Graph::forEachNameMatch(const NameMatcher &matcher,
+                             const std::function<bool(VertexID)> &fn) const {
+  auto &literal = matcher.getRequiredLiteral();
+  if (!literal.empty() && literal.find('\n') == std::string::npos) {
+    nameIndex->forEachContaining(literal, [&](VertexID v) {
+      return !matcher.match(graph[v].getName()) || fn(v);
+    });
+    return;
+  }
+  if (!matcher.match(std::string())) {
+    for (auto v : nameIndex->getVertices()) {
+      if (matcher.match(graph[v].getName()) && !fn(v)) {
+        return;
+      }
+    }
+    return;
+  }
   BGL_FORALL_VERTICES(v, graph, InternalGraph) {
-    if (graph[v].getName() == name) {
-      return v;
+    if (matcher.match(graph[v].getName()) && !fn(v)) {
+      return;
     }
   }
-  return nullVertex();
 }
 
-/// Lookup a vertex using a regex pattern and function specifying a type.
+/// Lookup a vertex using a name pattern and function specifying a type.
 VertexID Graph::getVertexDescRegex(const std::string &name,
                                    VertexGraphType graphType) const {
-  auto nameRegexStr(name);
-  // Ignoring '/' (when supplying a heirarchical ref).
-  std::replace(nameRegexStr.begin(), nameRegexStr.end(), '/', '.');
-  // Or '_' (when supplying a flattened name).
-  std::replace(nameRegexStr.begin(), nameRegexStr.end(), '_', '.');
-  // Wildcard matching.
-  if (Options::getInstance().getMatchWildcard()) {
-    boost::replace_all(nameRegexStr, "?", ".");
-    boost::replace_all(nameRegexStr, "*", ".*");
-  }
-  // Catch any errors in the regex string.
-  std::regex nameRegex;
-  try {
-    nameRegex.assign(nameRegexStr);
-  } catch(std::regex_error e) {
-    throw Exception(std::string("malformed regular expression: ")+e.what());
-  }
-  // Search the vertices.
-  // TODO: create a list of candidate vertices, rather than iterating all vertices.
-  BGL_FORALL_VERTICES(v, graph, InternalGraph) {
-    if (((graphType == VertexGraphType::ANY) ? true : graph[v].isGraphType(graphType)) &&
-        std::regex_search(graph[v].getName(), nameRegex)) {
-      return v;
+  auto result = nullVertex();
+  forEachNameMatch(createNameMatcher(name), [&](VertexID v) {
+    if (graphType == VertexGraphType::ANY || graph[v].isGraphType(graphType)) {
+      result = v;
+      return false;
+    }
+    return true;
+  });
+  return result;
+}
+
+/// Lookup all the variable vertices matching a name pattern.
+VertexIDVec Graph::getVerticesRegex(const std::string &name) const {
+  VertexIDVec matches;
+  forEachNameMatch(createNameMatcher(name), [&](VertexID v) {
+    if (!graph[v].isLogic()) {
+      matches.push_back(v);
+    }
+    return true;
+  });
+  return matches;
+}
+
+/// Lookup all the vertices of a type matching a name pattern, for each of a
+/// set of patterns and types, in a single scan of the named vertices.
+std::vector<VertexIDVec> Graph::getVerticesRegex(
+    const std::vector<std::pair<std::string, VertexGraphType>> &patterns) const {
+  std::vector<NameMatcher> matchers;
+  for (auto &pattern : patterns) {
+    matchers.push_back(createNameMatcher(pattern.first));
+  }
+  std::vector<VertexIDVec> matches(patterns.size());
+  for (auto v : nameIndex->getVertices()) {
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+      if ((patterns[i].second == VertexGraphType::ANY ||
+           graph[v].isGraphType(patterns[i].second)) &&
+          matchers[i].match(graph[v].getName())) {
+        matches[i].push_back(v);
+      }
     }
   }
-  return nullVertex();
+  return matches;
 }
 
 void Graph::dumpPath(const VertexIDVec &path) const {
@@ -240,134 +412,847 @@ VertexIDVec Graph::determinePath(ParentMap &parentMap,
   return determinePath(parentMap, path, startVertex, nextVertex);
 }
 
-/// Determine all paths between a start and an end point.
-/// This performs a DFS starting at the end point. It is not feasible for large
-/// graphs since the number of simple paths grows exponentially.
-void Graph::determineAllPaths(ParentMap &parentMap,
-                              std::vector<VertexIDVec> &result,
-                              VertexIDVec path,
-                              VertexID startVertex,
-                              VertexID finishVertex) const {
-  path.push_back(finishVertex);
-  if (finishVertex == startVertex) {
-    INFO(std::cout << "FOUND PATH\n");
-    result.push_back(path);
-    return;
+/// Depth-first traversal from a root vertex, following out edges or, if
+/// reverse is set, in edges, recording the parent of each vertex reached.
+/// Edges are followed in the same order as boost::depth_first_search, so the
+/// resulting tree is the same as the one it produces from the root. Vertices
+/// marked in avoid, if it is not empty, are not entered. Return false if the
+/// traversal is abandoned after reaching maxVertices vertices.
+bool Graph::traverseDFS(VertexID root,
+                        bool reverse,
+                        TraversalScratch &scratch,
+                        std::size_t maxVertices,
+                        const std::vector<bool> &avoid) const {
+  auto degree = [&](VertexID vertex) {
+    return reverse ? boost::in_degree(vertex, graph)
+                   : boost::out_degree(vertex, graph);
+  };
+  auto adjacent = [&](VertexID vertex, std::size_t index) {
+    return reverse ? boost::source(*(boost::in_edges(vertex, graph).first + index), graph)
+                   : boost::target(*(boost::out_edges(vertex, graph).first + index), graph);
+  };
+  scratch.reset(numVertices());
+  scratch.visit(root, root);
+  scratch.reached.push_back(root);
+  scratch.stack.push_back({root, 0, degree(root)});
+  std::size_t numVisited = 1;
+  while (!scratch.stack.empty()) {
+    auto &frame = scratch.stack.back();
+    if (frame.next == frame.end) {
+      scratch.stack.pop_back();
+      continue;
+    }
+    auto vertex = frame.vertex;
+    auto adjVertex = adjacent(vertex, frame.next++);
+    if (!scratch.isVisited(adjVertex) &&
+        (avoid.empty() || !avoid[adjVertex])) {
+      if (numVisited++ == maxVertices) {
+        return false;
+      }
+      scratch.visit(adjVertex, vertex);
+      scratch.reached.push_back(adjVertex);
+      scratch.stack.push_back({adjVertex, 0, degree(adjVertex)});
+    }
   }
-  INFO(std::cout<<"length "<<path.size()
-                <<" vertex "<<graph[finishVertex].toString()<<"\n");
-  INFO(dumpPath(path));
-  INFO(std::cout<<(parentMap[finishVertex].empty()?"DEAD END\n":""));
-  for (auto vertex : parentMap[finishVertex]) {
-    if (std::find(std::begin(path), std::end(path), vertex) == std::end(path)) {
-      determineAllPaths(parentMap, result, path, startVertex, vertex);
+  return true;
+}
+
+/// Level-synchronous breadth-first traversal, following out edges or, if
+/// reverse is set, in edges, from the vertices of the scratch frontier, which
+/// must already be visited, recording the parent of each vertex reached. Each
+/// level is expanded either top down, by scanning the
+/// edges of the frontier, or bottom up, by scanning each unvisited vertex for
+/// an edge from the frontier, which is cheaper once the frontier has more
+/// edges than a fraction of the unvisited part of the graph (Beamer et al.,
+/// direction-optimizing BFS). The work of each level is split into chunks
+/// distributed over numThreads threads, and the parents chosen do not depend
+/// on the number of threads. Vertices marked in avoid, if it is not empty, are
+/// not entered.
+void Graph::traverseBFS(bool reverse,
+                        TraversalScratch &scratch,
+                        unsigned numThreads,
+                        const std::vector<bool> &avoid) const {
+  // Switch to bottom up when the frontier edges exceed 1/ALPHA of the
+  // unexplored edges, and back to top down when the frontier has fewer than
+  // 1/BETA of the vertices.
+  constexpr std::size_t ALPHA = 14;
+  constexpr std::size_t BETA = 24;
+  // A multiple of 64, so each bottom-up chunk owns whole bitset words.
+  constexpr std::size_t CHUNK_SIZE = 4096;
+  auto degree = [&](VertexID vertex) {
+    return reverse ? boost::in_degree(vertex, graph)
+                   : boost::out_degree(vertex, graph);
+  };
+  auto size = numVertices();
+  auto &frontier = scratch.frontier;
+  auto &nextFrontier = scratch.nextFrontier;
+  auto &frontierBits = scratch.frontierBits;
+  std::size_t unexploredEdges = numEdges();
+  for (auto vertex : scratch.reached) {
+    unexploredEdges -= degree(vertex);
+  }
+  bool bottomUp = false;
+  std::vector<VertexIDVec> discovered;
+  std::vector<std::vector<VertexIDPair>> candidates;
+  while (!frontier.empty()) {
+    std::size_t frontierEdges = 0;
+    for (auto vertex : frontier) {
+      frontierEdges += degree(vertex);
+    }
+    if (!bottomUp && frontierEdges > unexploredEdges / ALPHA) {
+      bottomUp = true;
+    } else if (bottomUp && frontier.size() < size / BETA) {
+      bottomUp = false;
+    }
+    nextFrontier.clear();
+    if (bottomUp) {
+      frontierBits.assign((size + 63) / 64, 0);
+      for (auto vertex : frontier) {
+        frontierBits[vertex / 64] |= uint64_t(1) << (vertex % 64);
+      }
+      auto numChunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+      discovered.resize(numChunks);
+      parallelFor(numChunks, numThreads, [&](std::size_t chunk, unsigned) {
+        discovered[chunk].clear();
+        auto end = std::min(size, (chunk + 1) * CHUNK_SIZE);
+        for (auto vertex = chunk * CHUNK_SIZE; vertex < end; ++vertex) {
+          if (scratch.isVisited(vertex) || (!avoid.empty() && avoid[vertex])) {
+            continue;
+          }
+          auto isFrontier = [&](VertexID parent) {
+            if (frontierBits[parent / 64] & (uint64_t(1) << (parent % 64))) {
+              scratch.visit(vertex, parent);
+              discovered[chunk].push_back(vertex);
+              return true;
+            }
+            return false;
+          };
+          if (reverse) {
+            for (auto edges = boost::out_edges(vertex, graph);
+                 edges.first != edges.second; ++edges.first) {
+              if (isFrontier(boost::target(*edges.first, graph))) {
+                break;
+              }
+            }
+          } else {
+            for (auto edges = boost::in_edges(vertex, graph);
+                 edges.first != edges.second; ++edges.first) {
+              if (isFrontier(boost::source(*edges.first, graph))) {
+                break;
+              }
+            }
+          }
+        }
+      });
+      for (auto &vertices : discovered) {
+        nextFrontier.insert(std::end(nextFrontier),
+                            std::begin(vertices), std::end(vertices));
+      }
     } else {
-      INFO(std::cout << "CYCLE DETECTED\n");
+      // Collect the unvisited successors of each chunk of the frontier, then
+      // visit them in frontier order.
+      auto numChunks = (frontier.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+      candidates.resize(numChunks);
+      parallelFor(numChunks, numThreads, [&](std::size_t chunk, unsigned) {
+        candidates[chunk].clear();
+        auto end = std::min(frontier.size(), (chunk + 1) * CHUNK_SIZE);
+        for (auto i = chunk * CHUNK_SIZE; i < end; ++i) {
+          auto vertex = frontier[i];
+          auto addCandidate = [&](VertexID adjVertex) {
+            if (!scratch.isVisited(adjVertex) &&
+                (avoid.empty() || !avoid[adjVertex])) {
+              candidates[chunk].emplace_back(adjVertex, vertex);
+            }
+          };
+          if (reverse) {
+            BGL_FORALL_INEDGES(vertex, e, graph, InternalGraph) {
+              addCandidate(boost::source(e, graph));
+            }
+          } else {
+            BGL_FORALL_OUTEDGES(vertex, e, graph, InternalGraph) {
+              addCandidate(boost::target(e, graph));
+            }
+          }
+        }
+      });
+      for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+        for (auto &candidate : candidates[chunk]) {
+          if (!scratch.isVisited(candidate.first)) {
+            scratch.visit(candidate.first, candidate.second);
+            nextFrontier.push_back(candidate.first);
+          }
+        }
+      }
+    }
+    for (auto vertex : nextFrontier) {
+      unexploredEdges -= degree(vertex);
+    }
+    scratch.reached.insert(std::end(scratch.reached),
+                           std::begin(nextFrontier), std::end(nextFrontier));
+    std::swap(frontier, nextFrontier);
+  }
+}
+
+/// Traverse the graph from a root vertex, recording the parent of each vertex
+/// reached. A depth-first traversal is tried first and, if the cone of the
+/// root is found to have more vertices than the BFS threshold option (zero
+/// for no limit), is continued by a parallel breadth-first traversal from the
+/// vertices it has not finished, keeping the vertices it has already reached.
+/// Vertices marked in avoid, if it is not empty, are not entered. Return true
+/// if the depth-first traversal completed.
+bool Graph::traverse(VertexID root,
+                     bool reverse,
+                     TraversalScratch &scratch,
+                     unsigned numThreads,
+                     const std::vector<bool> &avoid) const {
+  auto threshold = QueryContext::current().bfsThreshold;
+  if (traverseDFS(root, reverse, scratch,
+                  threshold == 0 ? SIZE_MAX : threshold, avoid)) {
+    return true;
+  }
+  INFO(std::cout << "Cone of " << graph[root].getName() << " exceeds "
+                 << threshold << " vertices, switching to parallel BFS\n");
+  // Every vertex adjacent to a vertex the DFS has finished is already
+  // visited, so the rest of the cone is reached from the vertices on its
+  // stack.
+  scratch.frontier.clear();
+  for (auto &frame : scratch.stack) {
+    scratch.frontier.push_back(frame.vertex);
+  }
+  traverseBFS(reverse, scratch, numThreads, avoid);
+  return false;
+}
+
+/// Return the cache of traversal trees, creating it on first use.
+TraversalCache &Graph::getTraversalCache() const {
+  std::lock_guard<std::mutex> lock(traversalCacheMutex);
+  if (!traversalCache) {
+    traversalCache = std::make_shared<TraversalCache>();
+  }
+  return *traversalCache;
+}
+
+/// Return the traversal tree from a root vertex, from the cache if it holds
+/// one, otherwise by traversing the graph and adding the result to the cache.
+/// If depthFirst is set, the tree must come from a complete depth-first
+/// traversal, so that paths taken from it are the same as an uncached search.
+/// Traversals with avoid points are not cached, and reach nothing if the root
+/// is avoided.
+std::shared_ptr<const TraversalTree>
+Graph::getTraversalTree(VertexID root,
+                        bool reverse,
+                        bool depthFirst,
+                        TraversalScratch &scratch,
+                        unsigned numThreads,
+                        const std::vector<bool> &avoid) const {
+  auto capacity = avoid.empty() ? QueryContext::current().traversalCacheSize : 0;
+  if (!avoid.empty() && avoid[root]) {
+    scratch.reset(numVertices());
+    return std::make_shared<const TraversalTree>(root, reverse, true, scratch);
+  }
+  if (capacity > 0) {
+    auto tree = getTraversalCache().lookup(root, reverse);
+    if (tree && (tree->isDepthFirst() || !depthFirst)) {
+      return tree;
     }
   }
+  bool complete = depthFirst ? traverseDFS(root, reverse, scratch, SIZE_MAX, avoid)
+                             : traverse(root, reverse, scratch, numThreads, avoid);
+  auto tree = std::make_shared<const TraversalTree>(root, reverse, complete,
+                                                    scratch);
+  if (capacity > 0) {
+    getTraversalCache().insert(tree, capacity);
+  }
+  return tree;
+}
+
+TraversalCacheStats Graph::getTraversalCacheStats() const {
+  return getTraversalCache().getStats();
 }
 
-/// Report all paths fanning out from a net/register/port.
+void Graph::clearTraversalCache() const {
+  getTraversalCache().clear();
+}
+
+/// Return the path to each finish point reachable from a vertex, or from each
+/// start point reaching a vertex if reverse is set, ordered by vertex, not
+/// passing through any vertex marked in avoid.
 std::vector<VertexIDVec>
-Graph::getAllFanOut(VertexID startVertex) const {
-  INFO(std::cout << "Performing DFS from "
-                 << graph[startVertex].getName() << "\n");
-  ParentMap parentMap;
-  boost::depth_first_search(graph,
-      boost::visitor(DfsVisitor(parentMap, false))
-        .root_vertex(startVertex));
-  // Check for a path between startPoint and each register.
+Graph::determineFanPaths(VertexID vertex,
+                         bool reverse,
+                         TraversalScratch &scratch,
+                         unsigned numThreads,
+                         const std::vector<bool> &avoid) const {
+  FanPathEnumerator enumerator(
+      *this, getTraversalTree(vertex, reverse, false, scratch, numThreads, avoid));
   std::vector<VertexIDVec> paths;
-  BGL_FORALL_VERTICES(v, graph, InternalGraph) {
-    if (graph[v].isFinishPoint()) {
-      auto path = determinePath(parentMap,
-                                VertexIDVec(),
-                                startVertex,
-                                static_cast<VertexID>(v));
-      if (!path.empty()) {
-        std::reverse(std::begin(path), std::end(path));
-        paths.push_back(path);
-      }
-    }
+  VertexIDVec path;
+  while (enumerator.next(path)) {
+    paths.push_back(path);
   }
   return paths;
 }
 
-/// Report all paths fanning into a net/register/port.
+/// Return an enumerator of the paths to each finish point reachable from a
+/// vertex, or from each start point reaching a vertex if reverse is set, not
+/// passing through any vertex marked in avoid.
+std::unique_ptr<PathEnumerator>
+Graph::enumerateFanPaths(VertexID vertex, bool reverse,
+                         const std::vector<bool> &avoid) const {
+  INFO(std::cout << "Performing DFS" << (reverse ? " in reverse graph" : "")
+                 << " from " << graph[vertex].getName() << "\n");
+  auto &scratch = QueryContext::current().scratch;
+  return std::make_unique<FanPathEnumerator>(
+      *this, getTraversalTree(vertex, reverse, false, scratch, getNumThreads(),
+                              avoid));
+}
+
+/// Report all paths fanning out from a net/register/port, avoiding any
+/// vertices marked in avoid.
 std::vector<VertexIDVec>
-Graph::getAllFanIn(VertexID finishVertex) const {
-  auto reverseGraph = boost::make_reverse_graph(graph);
+Graph::getAllFanOut(VertexID startVertex,
+                    const std::vector<bool> &avoid) const {
+  INFO(std::cout << "Performing DFS from "
+                 << graph[startVertex].getName() << "\n");
+  auto &scratch = QueryContext::current().scratch;
+  return determineFanPaths(startVertex, false, scratch, getNumThreads(), avoid);
+}
+
+/// Report all paths fanning into a net/register/port, avoiding any vertices
+/// marked in avoid.
+std::vector<VertexIDVec>
+Graph::getAllFanIn(VertexID finishVertex,
+                   const std::vector<bool> &avoid) const {
   INFO(std::cout << "Performing DFS in reverse graph from "
                  << graph[finishVertex].getName() << "\n");
-  ParentMap parentMap;
-  boost::depth_first_search(reverseGraph,
-      boost::visitor(DfsVisitor(parentMap, false))
-        .root_vertex(finishVertex));
-  // Check for a path between endPoint and each register.
-  std::vector<VertexIDVec> paths;
-  BGL_FORALL_VERTICES(v, graph, InternalGraph) {
-    if (graph[v].isStartPoint()) {
-      auto path = determinePath(parentMap,
-                                VertexIDVec(),
-                                finishVertex,
-                                static_cast<VertexID>(v));
-      if (!path.empty()) {
-        paths.push_back(path);
+  auto &scratch = QueryContext::current().scratch;
+  return determineFanPaths(finishVertex, true, scratch, getNumThreads(), avoid);
+}
+
+/// Report all paths fanning out from each of a set of start points, in the
+/// same order, avoiding any vertices marked in avoid. The traversals are
+/// distributed over a set of threads.
+std::vector<std::vector<VertexIDVec>>
+Graph::getAllFanOut(const VertexIDVec &startVertices,
+                    const std::vector<bool> &avoid) const {
+  INFO(std::cout << "Performing DFS from " << startVertices.size()
+                 << " start points\n");
+  std::vector<std::vector<VertexIDVec>> result(startVertices.size());
+  std::vector<TraversalScratch> scratch(getNumThreads());
+  parallelFor(startVertices.size(), [&](std::size_t i, unsigned threadIndex) {
+    result[i] = determineFanPaths(startVertices[i], false, scratch[threadIndex], 1,
+                                  avoid);
+  });
+  return result;
+}
+
+/// Report all paths fanning into each of a set of finish points, in the same
+/// order, avoiding any vertices marked in avoid. The traversals are
+/// distributed over a set of threads.
+std::vector<std::vector<VertexIDVec>>
+Graph::getAllFanIn(const VertexIDVec &finishVertices,
+                   const std::vector<bool> &avoid) const {
+  INFO(std::cout << "Performing DFS in reverse graph from "
+                 << finishVertices.size() << " finish points\n");
+  std::vector<std::vector<VertexIDVec>> result(finishVertices.size());
+  std::vector<TraversalScratch> scratch(getNumThreads());
+  parallelFor(finishVertices.size(), [&](std::size_t i, unsigned threadIndex) {
+    result[i] = determineFanPaths(finishVertices[i], true, scratch[threadIndex], 1,
+                                  avoid);
+  });
+  return result;
+}
+
+/// Return the number of finish points reachable from a start point.
+size_t Graph::getfanOutDegree(VertexID startVertex) const {
+  auto &scratch = QueryContext::current().scratch;
+  auto tree = getTraversalTree(startVertex, false, false, scratch, getNumThreads(), {});
+  size_t degree = 0;
+  for (auto &reached : *tree) {
+    if (graph[reached.first].isFinishPoint()) {
+      degree++;
+    }
+  }
+  return degree;
+}
+
+/// Return the number of start points that reach a finish point.
+size_t Graph::getFanInDegree(VertexID finishVertex) const {
+  auto &scratch = QueryContext::current().scratch;
+  auto tree = getTraversalTree(finishVertex, true, false, scratch, getNumThreads(), {});
+  size_t degree = 0;
+  for (auto &reached : *tree) {
+    if (graph[reached.first].isStartPoint()) {
+      degree++;
+    }
+  }
+  return degree;
+}
+
+/// Add to counts the number of targets in [begin, begin + words * bits per
+/// word) that each point reaches or, if fanIn is set, is reached by, using
+/// blockBits for a bitset of that many words per component.
+template<typename Word>
+static void countDegreeBlock(const Condensation &sccs,
+                             bool fanIn,
+                             const VertexIDVec &points,
+                             const VertexIDVec &targets,
+                             std::size_t begin,
+                             std::size_t words,
+                             std::vector<Word> &blockBits,
+                             std::vector<size_t> &counts) {
+  constexpr std::size_t WORD_BITS = sizeof(Word) * 8;
+  auto numComponents = sccs.getNumComponents();
+  blockBits.assign(numComponents * words, 0);
+  auto end = std::min(targets.size(), begin + words * WORD_BITS);
+  for (auto i = begin; i < end; ++i) {
+    auto bit = i - begin;
+    auto component = sccs.getComponent(targets[i]);
+    blockBits[component * words + bit / WORD_BITS] |= Word(1) << (bit % WORD_BITS);
+  }
+  if (fanIn) {
+    for (std::size_t c = 0; c < numComponents; ++c) {
+      for (auto s = sccs.successorsBegin(c); s != sccs.successorsEnd(c); ++s) {
+        for (std::size_t w = 0; w < words; ++w) {
+          blockBits[*s * words + w] |= blockBits[c * words + w];
+        }
+      }
+    }
+  } else {
+    for (std::size_t c = numComponents; c-- > 0;) {
+      for (auto s = sccs.successorsBegin(c); s != sccs.successorsEnd(c); ++s) {
+        for (std::size_t w = 0; w < words; ++w) {
+          blockBits[c * words + w] |= blockBits[*s * words + w];
+        }
       }
     }
   }
-  return paths;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    auto component = sccs.getComponent(points[i]);
+    for (std::size_t w = 0; w < words; ++w) {
+      counts[i] += __builtin_popcountll(blockBits[component * words + w]);
+    }
+  }
 }
 
-/// Report all paths between start and finish points.
+/// Count the finish points reachable from every start point or, if fanIn is
+/// set, the start points reaching every finish point, in one sweep of the
+/// condensed graph. Each component is given a bitset of the points it reaches
+/// (or is reached by), formed from the bitsets of its successors in reverse
+/// topological order (or pushed to its successors in topological order). To
+/// bound memory, the points are counted in blocks sized so that the bitsets
+/// of all the components fit in a per-thread budget, using 64-bit words, or
+/// bytes once a component's share of the budget is less than a word, with the
+/// blocks distributed over a set of threads.
+std::vector<std::pair<VertexID, size_t>>
+Graph::determineDegrees(bool fanIn) const {
+  // Bound the bitset memory of each thread to 64 MB. With more than 64M
+  // components, one byte each is used, less than the condensation itself.
+  constexpr std::size_t MAX_BITSET_BYTES = std::size_t(64) << 20;
+  auto &sccs = getCondensation();
+  auto numComponents = sccs.getNumComponents();
+  VertexIDVec points;
+  VertexIDVec targets;
+  BGL_FORALL_VERTICES(v, graph, InternalGraph) {
+    if (fanIn ? graph[v].isFinishPoint() : graph[v].isStartPoint()) {
+      points.push_back(v);
+    }
+    if (fanIn ? graph[v].isStartPoint() : graph[v].isFinishPoint()) {
+      targets.push_back(v);
+    }
+  }
+  auto maxBytes = MAX_BITSET_BYTES / std::max<std::size_t>(1, numComponents);
+  bool wide = maxBytes >= sizeof(uint64_t);
+  std::size_t wordBits = wide ? 64 : 8;
+  auto totalWords = (targets.size() + wordBits - 1) / wordBits;
+  auto maxWords = wide ? maxBytes / sizeof(uint64_t) : maxBytes;
+  auto words = std::max<std::size_t>(1, std::min(totalWords, maxWords));
+  auto numBlocks = (totalWords + words - 1) / words;
+  auto numThreads = std::min<std::size_t>(getNumThreads(), numBlocks);
+  std::vector<std::vector<uint64_t>> wideBits(wide ? numThreads : 0);
+  std::vector<std::vector<uint8_t>> narrowBits(wide ? 0 : numThreads);
+  std::vector<std::vector<size_t>> counts(numThreads,
+                                          std::vector<size_t>(points.size()));
+  parallelFor(numBlocks, numThreads, [&](std::size_t block, unsigned thread) {
+    auto begin = block * words * wordBits;
+    if (wide) {
+      countDegreeBlock(sccs, fanIn, points, targets, begin, words,
+                       wideBits[thread], counts[thread]);
+    } else {
+      countDegreeBlock(sccs, fanIn, points, targets, begin, words,
+                       narrowBits[thread], counts[thread]);
+    }
+  });
+  std::vector<std::pair<VertexID, size_t>> degrees;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    size_t degree = 0;
+    for (auto &threadCounts : counts) {
+      degree += threadCounts[i];
+    }
+    degrees.emplace_back(points[i], degree);
+  }
+  return degrees;
+}
+
+/// Return the fan out degree of every start point, ordered by vertex.
+std::vector<std::pair<VertexID, size_t>> Graph::getAllFanOutDegrees() const {
+  return determineDegrees(false);
+}
+
+/// Return the fan in degree of every finish point, ordered by vertex.
+std::vector<std::pair<VertexID, size_t>> Graph::getAllFanInDegrees() const {
+  return determineDegrees(true);
+}
+
+/// Return the vertices reachable from any of a set of root vertices or, if
+/// reverse is set, the vertices that reach any of them, in vertex order.
+VertexIDVec Graph::getCone(const VertexIDVec &roots, bool reverse) const {
+  std::vector<bool> inCone(numVertices(), false);
+  auto &scratch = QueryContext::current().scratch;
+  for (auto root : roots) {
+    if (inCone[root]) {
+      continue;
+    }
+    traverse(root, reverse, scratch, getNumThreads(), {});
+    for (auto v : scratch.reached) {
+      inCone[v] = true;
+    }
+  }
+  VertexIDVec cone;
+  BGL_FORALL_VERTICES(v, graph, InternalGraph) {
+    if (inCone[v]) {
+      cone.push_back(v);
+    }
+  }
+  return cone;
+}
+
+/// Copy a set of vertices, given in vertex order, and the edges between them
+/// into an empty graph. The copies are numbered in the same order, and share
+/// the data types and locations of the originals.
+void Graph::copySubgraph(const VertexIDVec &vertices, Graph &subgraph) const {
+  std::vector<VertexID> mapping(numVertices(), nullVertex());
+  for (auto vertex : vertices) {
+    mapping[vertex] = boost::add_vertex(graph[vertex], subgraph.graph);
+    if (!graph[vertex].isLogic()) {
+      subgraph.nameIndex->insert(graph[vertex].getName(), mapping[vertex]);
+    }
+  }
+  // Add the edges in the order of the original graph, so that the order of
+  // the out and in edges of each vertex, and therefore traversals, are the
+  // same.
+  BGL_FORALL_EDGES(e, graph, InternalGraph) {
+    auto src = mapping[boost::source(e, graph)];
+    auto dst = mapping[boost::target(e, graph)];
+    if (src != nullVertex() && dst != nullVertex()) {
+      boost::add_edge(src, dst, subgraph.graph);
+    }
+  }
+  INFO(std::cout << "Copied subgraph of " << subgraph.numVertices()
+                 << " vertices and " << subgraph.numEdges() << " edges\n");
+}
+
+/// Return an enumerator of all paths between start and finish points.
 /// Though points currently unsupported.
-std::vector<VertexIDVec>
-Graph::getAllPointToPoint(const VertexIDVec &waypoints) const {
+std::unique_ptr<PathEnumerator>
+Graph::enumerateAllPointToPoint(const VertexIDVec &waypoints,
+                                const std::vector<bool> &avoid) const {
   assert(waypoints.size() == 2 && "through points not supported with all point to point");
-  INFO(std::cout << "Performing DFS\n");
+  if (!avoid.empty() && (avoid[waypoints[0]] || avoid[waypoints[1]])) {
+    // No path starts or finishes at an avoided point.
+    return std::make_unique<EmptyPathEnumerator>();
+  }
+  INFO(std::cout << "Performing DFS from "
+                 << graph[waypoints[0]].getName() << "\n");
+  // Record each edge examined by a depth-first traversal from the start
+  // point, in the order examined, so each vertex lists its predecessors that
+  // are reachable from the start point. Avoided vertices are not entered.
+  auto &scratch = QueryContext::current().scratch;
   ParentMap parentMap;
-  boost::depth_first_search(graph,
-      boost::visitor(DfsVisitor(parentMap, true))
-        .root_vertex(waypoints[0]));
+  scratch.reset(numVertices());
+  scratch.visit(waypoints[0], waypoints[0]);
+  scratch.stack.push_back({waypoints[0], 0, boost::out_degree(waypoints[0], graph)});
+  while (!scratch.stack.empty()) {
+    auto &frame = scratch.stack.back();
+    if (frame.next == frame.end) {
+      scratch.stack.pop_back();
+      continue;
+    }
+    auto vertex = frame.vertex;
+    auto adjVertex = boost::target(
+        *(boost::out_edges(vertex, graph).first + frame.next++), graph);
+    if (!avoid.empty() && avoid[adjVertex]) {
+      continue;
+    }
+    parentMap[adjVertex].push_back(vertex);
+    if (!scratch.isVisited(adjVertex)) {
+      scratch.visit(adjVertex, vertex);
+      scratch.stack.push_back({adjVertex, 0, boost::out_degree(adjVertex, graph)});
+    }
+  }
+  return std::make_unique<AllPathsEnumerator>(std::move(parentMap),
+                                              waypoints[0], waypoints[1]);
+}
+
+/// Report all paths between start and finish points.
+/// Though points currently unsupported.
+std::vector<VertexIDVec>
+Graph::getAllPointToPoint(const VertexIDVec &waypoints,
+                          const std::vector<bool> &avoid) const {
+  auto enumerator = enumerateAllPointToPoint(waypoints, avoid);
   INFO(std::cout << "Determining all paths\n");
   std::vector<VertexIDVec> paths;
-  determineAllPaths(parentMap,
-                    paths,
-                    VertexIDVec(),
-                    waypoints[0],
-                    waypoints[1]);
-  for (auto &path : paths) {
-    std::reverse(std::begin(path), std::end(path));
+  VertexIDVec path;
+  while (enumerator->next(path)) {
+    paths.push_back(path);
   }
   return paths;
 }
 
 /// Report a single path between a set of named points.
-VertexIDVec Graph::getAnyPointToPoint(const VertexIDVec &waypoints) const {
+VertexIDVec Graph::getAnyPointToPoint(const VertexIDVec &waypoints,
+                                      const std::vector<bool> &avoid) const {
   std::vector<VertexID> path;
+  auto &scratch = QueryContext::current().scratch;
   // Construct the path between each adjacent waypoints.
   for (std::size_t i = 0; i < waypoints.size()-1; ++i) {
     auto startVertex = waypoints[i];
     auto finishVertex = waypoints[i+1];
     INFO(std::cout << "Performing DFS from "
                    << graph[startVertex].getName() << "\n");
-    ParentMap parentMap;
-    boost::depth_first_search(graph,
-        boost::visitor(DfsVisitor(parentMap, false))
-          .root_vertex(startVertex));
-    INFO(std::cout << "Determining a path to "
-                   << graph[finishVertex].getName() << "\n");
-    auto subPath = determinePath(parentMap,
-                                 VertexIDVec(),
-                                 startVertex,
-                                 finishVertex);
+    VertexIDVec subPath;
+    if (avoid.empty()) {
+      // Traversals without avoid points are cached.
+      auto tree = getTraversalTree(startVertex, false, true, scratch, 1, {});
+      INFO(std::cout << "Determining a path to "
+                     << graph[finishVertex].getName() << "\n");
+      if (!tree->isReached(finishVertex)) {
+        // No path exists.
+        return VertexIDVec();
+      }
+      for (auto v = finishVertex; v != startVertex; v = tree->getParent(v)) {
+        subPath.push_back(v);
+      }
+    } else {
+      if (avoid[startVertex] || avoid[finishVertex]) {
+        return VertexIDVec();
+      }
+      traverseDFS(startVertex, false, scratch, SIZE_MAX, avoid);
+      INFO(std::cout << "Determining a path to "
+                     << graph[finishVertex].getName() << "\n");
+      if (!scratch.isVisited(finishVertex)) {
+        // No path exists.
+        return VertexIDVec();
+      }
+      for (auto v = finishVertex; v != startVertex; v = scratch.parents[v]) {
+        subPath.push_back(v);
+      }
+    }
     if (subPath.empty()) {
-      // No path exists.
-      return VertexIDVec();
+      // The leg starts and finishes at the same point, such as an inout port.
+      continue;
     }
     std::reverse(std::begin(subPath), std::end(subPath));
+    path.push_back(startVertex);
     path.insert(std::end(path), std::begin(subPath), std::end(subPath)-1);
   }
   path.push_back(waypoints.back());
   return path;
 }
+
+/// Propagate a mask of up to 64 start points through the graph, setting bit k
+/// of each vertex reachable from startVertices[k] without passing through an
+/// avoided vertex. The queued flags are left clear for the next call.
+void Graph::propagateReachability(const VertexID *startVertices,
+                                  std::size_t numStartVertices,
+                                  const std::vector<bool> &avoid,
+                                  std::vector<uint64_t> &reached,
+                                  std::vector<bool> &queued) const {
+  std::fill(std::begin(reached), std::end(reached), 0);
+  std::deque<VertexID> worklist;
+  // Seed the traversal with the start points.
+  for (std::size_t k = 0; k < numStartVertices; ++k) {
+    auto startVertex = startVertices[k];
+    if (!avoid.empty() && avoid[startVertex]) {
+      continue;
+    }
+    reached[startVertex] |= uint64_t(1) << k;
+    if (!queued[startVertex]) {
+      queued[startVertex] = true;
+      worklist.push_back(startVertex);
+    }
+  }
+  // Propagate the masks until no vertex gains any new start points.
+  while (!worklist.empty()) {
+    auto vertex = worklist.front();
+    worklist.pop_front();
+    queued[vertex] = false;
+    auto mask = reached[vertex];
+    BGL_FORALL_ADJ(vertex, adjVertex, graph, InternalGraph) {
+      if ((mask & ~reached[adjVertex]) &&
+          (avoid.empty() || !avoid[adjVertex])) {
+        reached[adjVertex] |= mask;
+        if (!queued[adjVertex]) {
+          queued[adjVertex] = true;
+          worklist.push_back(adjVertex);
+        }
+      }
+    }
+  }
+}
+
+/// Report whether a path exists between each pair of start and finish points.
+/// The distinct start points are processed in groups of 64, with each group
+/// propagated through the graph in a single traversal, using one bit of a
+/// 64-bit mask per start point.
+std::vector<bool>
+Graph::getPointToPointReachability(const std::vector<VertexIDPair> &pairs,
+                                   const std::vector<bool> &avoid) const {
+  // Assign each distinct start point an index and bucket the pairs by the
+  // group their start point belongs to.
+  std::unordered_map<VertexID, std::size_t> startIndexes;
+  VertexIDVec startVertices;
+  std::vector<std::vector<std::size_t>> groupPairs;
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    auto inserted = startIndexes.emplace(pairs[i].first, startVertices.size());
+    if (inserted.second) {
+      startVertices.push_back(pairs[i].first);
+    }
+    auto group = inserted.first->second / REACHABILITY_GROUP_SIZE;
+    if (group >= groupPairs.size()) {
+      groupPairs.resize(group + 1);
+    }
+    groupPairs[group].push_back(i);
+  }
+  INFO(std::cout << "Determining reachability of " << pairs.size()
+                 << " pairs from " << startVertices.size() << " start points\n");
+  std::vector<bool> result(pairs.size(), false);
+  std::vector<uint64_t> reached(numVertices());
+  std::vector<bool> queued(numVertices());
+  for (std::size_t group = 0; group < groupPairs.size(); ++group) {
+    auto begin = group * REACHABILITY_GROUP_SIZE;
+    auto count = std::min(REACHABILITY_GROUP_SIZE, startVertices.size() - begin);
+    propagateReachability(startVertices.data() + begin, count, avoid,
+                          reached, queued);
+    for (auto i : groupPairs[group]) {
+      auto bit = startIndexes[pairs[i].first] % REACHABILITY_GROUP_SIZE;
+      result[i] = (reached[pairs[i].second] >> bit) & 1;
+    }
+  }
+  return result;
+}
+
+/// Report whether a path exists from each start point to each finish point,
+/// as rows of the finish points reached by each start point, without passing
+/// through any vertex marked in avoid. The start points are processed in
+/// groups of 64 as for getPointToPointReachability, with each group filling
+/// its rows directly.
+std::vector<std::vector<bool>>
+Graph::getReachabilityMatrix(const VertexIDVec &startVertices,
+                             const VertexIDVec &finishVertices,
+                             const std::vector<bool> &avoid) const {
+  INFO(std::cout << "Determining reachability of " << startVertices.size()
+                 << " start points to " << finishVertices.size()
+                 << " finish points\n");
+  std::vector<std::vector<bool>> connected(startVertices.size(),
+      std::vector<bool>(finishVertices.size(), false));
+  std::vector<uint64_t> reached(numVertices());
+  std::vector<bool> queued(numVertices());
+  for (std::size_t begin = 0; begin < startVertices.size();
+       begin += REACHABILITY_GROUP_SIZE) {
+    auto count = std::min(REACHABILITY_GROUP_SIZE, startVertices.size() - begin);
+    propagateReachability(startVertices.data() + begin, count, avoid,
+                          reached, queued);
+    for (std::size_t j = 0; j < finishVertices.size(); ++j) {
+      auto mask = reached[finishVertices[j]];
+      while (mask) {
+        auto bit = __builtin_ctzll(mask);
+        connected[begin + bit][j] = true;
+        mask &= mask - 1;
+      }
+    }
+  }
+  return connected;
+}
+
+/// Return a path from each start point to each finish point it is connected
+/// to in a reachability matrix, the same path as getAnyPointToPoint for the
+/// pair, not passing through any vertex marked in avoid. Each start point is
+/// traversed once for all of its finish points, with the traversals
+/// distributed over a set of threads.
+std::vector<std::vector<VertexIDVec>>
+Graph::getMatrixPaths(const VertexIDVec &startVertices,
+                      const VertexIDVec &finishVertices,
+                      const std::vector<std::vector<bool>> &connected,
+                      const std::vector<bool> &avoid) const {
+  INFO(std::cout << "Determining paths from " << startVertices.size()
+                 << " start points to " << finishVertices.size()
+                 << " finish points\n");
+  std::vector<std::vector<VertexIDVec>> paths(startVertices.size(),
+      std::vector<VertexIDVec>(finishVertices.size()));
+  std::vector<TraversalScratch> scratch(getNumThreads());
+  parallelFor(startVertices.size(), [&](std::size_t i, unsigned threadIndex) {
+    auto startVertex = startVertices[i];
+    if (std::none_of(std::begin(connected[i]), std::end(connected[i]),
+                     [](bool c) { return c; }) ||
+        (!avoid.empty() && avoid[startVertex])) {
+      return;
+    }
+    auto &threadScratch = scratch[threadIndex];
+    traverseDFS(startVertex, false, threadScratch, SIZE_MAX, avoid);
+    for (std::size_t j = 0; j < finishVertices.size(); ++j) {
+      auto finishVertex = finishVertices[j];
+      if (!connected[i][j] || !threadScratch.isVisited(finishVertex)) {
+        continue;
+      }
+      auto &path = paths[i][j];
+      for (auto v = finishVertex; v != startVertex; v = threadScratch.parents[v]) {
+        path.push_back(v);
+      }
+      path.push_back(startVertex);
+      std::reverse(std::begin(path), std::end(path));
+    }
+  });
+  return paths;
+}
+
+/// Return the strongly-connected components of the graph, determining them on
+/// first use. The graph must not be modified after this.
+const Condensation &Graph::getCondensation() const {
+  std::lock_guard<std::mutex> lock(condensationMutex);
+  if (!condensation) {
+    condensation = std::make_shared<const Condensation>(*this);
+  }
+  return *condensation;
+}
+
+/// Report the vertices of each combinational loop in the graph.
+std::vector<VertexIDVec> Graph::getCombLoops() const {
+  auto &sccs = getCondensation();
+  std::vector<VertexIDVec> loops;
+  for (auto component : sccs.getLoops()) {
+    loops.push_back(VertexIDVec(sccs.membersBegin(component),
+                                sccs.membersEnd(component)));
+  }
+  return loops;
+}
+
+/// Return the logic depths of the graph, determining them on first use. The
+/// graph must not be modified after this.
+const LogicDepth &Graph::getLogicDepth() const {
+  std::lock_guard<std::mutex> lock(logicDepthMutex);
+  if (!logicDepth) {
+    logicDepth = std::make_shared<const LogicDepth>(*this);
+  }
+  return *logicDepth;
+}
+
+/// Return the register graph, building it on first use. The graph must not
+/// be modified after this.
+const RegisterGraph &Graph::getRegisterGraph() const {
+  std::lock_guard<std::mutex> lock(registerGraphMutex);
+  if (!registerGraph) {
+    registerGraph = std::make_shared<const RegisterGraph>(*this);
+  }
+  return *registerGraph;
+}
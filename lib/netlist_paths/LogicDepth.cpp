@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <boost/graph/iteration_macros.hpp>
+#include "netlist_paths/Condensation.hpp"
+#include "netlist_paths/Debug.hpp"
+#include "netlist_paths/LogicDepth.hpp"
+#include "netlist_paths/Options.hpp"
+
+using namespace netlist_paths;
+
+LogicDepth::LogicDepth(const Graph &graph) : graph(graph) {
+  INFO(std::cout << "Determining logic depths\n");
+  determineDepths();
+}
+
+/// Visit the components in topological order, giving each vertex the largest
+/// depth of its predecessors in earlier components, plus one if it is logic.
+/// The vertices of a component without logic all take the largest depth of
+/// any of them, with parents assigned by a search within the component from
+/// the vertex it is entered at.
+void LogicDepth::determineDepths() {
+  auto &sccs = graph.getCondensation();
+  auto &loops = sccs.getLoops();
+  std::vector<bool> isLoop(sccs.getNumComponents(), false);
+  for (auto component : loops) {
+    isLoop[component] = true;
+  }
+  depths.assign(graph.numVertices(), -1);
+  parents.assign(graph.numVertices(), graph.nullVertex());
+  VertexIDVec queue;
+  std::vector<bool> queued(graph.numVertices(), false);
+  for (uint32_t c = 0; c < sccs.getNumComponents(); ++c) {
+    if (isLoop[c]) {
+      continue;
+    }
+    VertexID entry = graph.nullVertex();
+    for (auto v = sccs.membersBegin(c); v != sccs.membersEnd(c); ++v) {
+      auto vertex = *v;
+      if (graph.graph[vertex].isStartPoint()) {
+        depths[vertex] = 0;
+      }
+      BGL_FORALL_INEDGES(vertex, e, graph.graph, InternalGraph) {
+        auto src = boost::source(e, graph.graph);
+        if (sccs.getComponent(src) != c && depths[src] > depths[vertex]) {
+          depths[vertex] = depths[src];
+          parents[vertex] = src;
+        }
+      }
+      if (depths[vertex] >= 0 && graph.graph[vertex].isLogic()) {
+        depths[vertex]++;
+      }
+      if (entry == graph.nullVertex() || depths[vertex] > depths[entry]) {
+        entry = vertex;
+      }
+    }
+    if (sccs.getNumMembers(c) == 1 || depths[entry] < 0) {
+      continue;
+    }
+    // Search the component from the entry vertex.
+    queue.assign(1, entry);
+    queued[entry] = true;
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      BGL_FORALL_ADJ(queue[i], adjVertex, graph.graph, InternalGraph) {
+        if (sccs.getComponent(adjVertex) == c && !queued[adjVertex]) {
+          queued[adjVertex] = true;
+          depths[adjVertex] = depths[entry];
+          parents[adjVertex] = queue[i];
+          queue.push_back(adjVertex);
+        }
+      }
+    }
+  }
+}
+
+/// Return the longest path to a finish point, or an empty path if it has no
+/// depth.
+VertexIDVec LogicDepth::getPath(VertexID finishVertex) const {
+  VertexIDVec path;
+  if (depths[finishVertex] < 0) {
+    return path;
+  }
+  for (auto v = finishVertex; v != graph.nullVertex(); v = parents[v]) {
+    path.push_back(v);
+  }
+  std::reverse(std::begin(path), std::end(path));
+  return path;
+}
+
+/// Return the depth of each finish point that has one, ordered by vertex.
+std::vector<std::pair<VertexID, std::size_t>>
+LogicDepth::getFinishDepths() const {
+  std::vector<std::pair<VertexID, std::size_t>> result;
+  BGL_FORALL_VERTICES(v, graph.graph, InternalGraph) {
+    if (graph.graph[v].isFinishPoint() && depths[v] >= 0) {
+      result.emplace_back(v, depths[v]);
+    }
+  }
+  return result;
+}
+
+/// Return the k finish points with the largest depths, deepest first, with
+/// ties broken by vertex order. A bounded heap holds the k deepest seen.
+std::vector<std::pair<VertexID, std::size_t>>
+LogicDepth::getDeepest(std::size_t k) const {
+  using Entry = std::pair<VertexID, std::size_t>;
+  auto deeper = [](const Entry &a, const Entry &b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(deeper)> heap(deeper);
+  if (k == 0) {
+    return {};
+  }
+  for (auto &entry : getFinishDepths()) {
+    if (heap.size() < k) {
+      heap.push(entry);
+    } else if (deeper(entry, heap.top())) {
+      heap.pop();
+      heap.push(entry);
+    }
+  }
+  std::vector<Entry> result;
+  while (!heap.empty()) {
+    result.push_back(heap.top());
+    heap.pop();
+  }
+  std::reverse(std::begin(result), std::end(result));
+  return result;
+}
+
+/// Return the number of finish points with each depth, indexed by depth.
+std::vector<std::size_t> LogicDepth::getHistogram() const {
+  std::vector<std::size_t> histogram;
+  for (auto &entry : getFinishDepths()) {
+    if (entry.second >= histogram.size()) {
+      histogram.resize(entry.second + 1, 0);
+    }
+    histogram[entry.second]++;
+  }
+  return histogram;
+}
+
+/// Return the depth statistics of the finish points grouped by the module
+/// instance they belong to, ordered by name. A name's module is everything
+/// before its last '.', with top-level ports belonging to the empty name.
+std::vector<LogicDepth::ModuleStats> LogicDepth::getModuleStats() const {
+  std::map<std::string, ModuleStats> modules;
+  for (auto &entry : getFinishDepths()) {
+    auto name = graph.getVertex(entry.first).getName();
+    auto pos = name.rfind('.');
+    auto module = pos == std::string::npos ? std::string() : name.substr(0, pos);
+    auto it = modules.emplace(module, ModuleStats{module, 0, 0, 0}).first;
+    it->second.numFinishPoints++;
+    it->second.maxDepth = std::max(it->second.maxDepth, entry.second);
+    it->second.totalDepth += entry.second;
+  }
+  std::vector<ModuleStats> result;
+  for (auto &module : modules) {
+    result.push_back(module.second);
+  }
+  return result;
+}
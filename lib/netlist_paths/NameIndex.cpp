@@ -0,0 +1,125 @@
+#include <algorithm>
+#include "netlist_paths/NameIndex.hpp"
+
+using namespace netlist_paths;
+
+constexpr uint32_t NameIndex::NULL_NODE;
+
+/// Call fn with each '.'-separated component of a name, including any empty
+/// components. An empty name has no components.
+template<typename Fn>
+static void forEachComponent(const std::string &name, Fn fn) {
+  if (name.empty()) {
+    return;
+  }
+  std::size_t begin = 0;
+  while (true) {
+    auto end = name.find('.', begin);
+    if (end == std::string::npos) {
+      fn(name.substr(begin));
+      return;
+    }
+    fn(name.substr(begin, end - begin));
+    begin = end + 1;
+  }
+}
+
+void NameIndex::insert(const std::string &name, VertexID vertex) {
+  exact.emplace(name, vertex);
+  blobOffsets.push_back(blob.size());
+  blobVertices.push_back(vertex);
+  blob.append(name);
+  blob.push_back('\n');
+  uint32_t node = 0;
+  forEachComponent(name, [&](const std::string &component) {
+    auto it = nodes[node].children.find(component);
+    if (it == nodes[node].children.end()) {
+      it = nodes[node].children.emplace(component, nodes.size()).first;
+      nodes.push_back(Node{{}, {}, &it->first, nodes[node].depth + 1});
+    }
+    node = it->second;
+  });
+  nodes[node].vertices.push_back(vertex);
+  if (vertex >= vertexNodes.size()) {
+    vertexNodes.resize(vertex + 1, NULL_NODE);
+  }
+  vertexNodes[vertex] = node;
+  rangesValid = false;
+}
+
+/// Return the trie node of a scope, or null if there are no names within it.
+/// Components of the scope can be separated by '/' as well as '.'.
+const NameIndex::Node *NameIndex::findNode(const std::string &scope) const {
+  const Node *node = &nodes[0];
+  bool found = true;
+  auto path = scope;
+  std::replace(std::begin(path), std::end(path), '/', '.');
+  forEachComponent(path, [&](const std::string &component) {
+    if (!found) {
+      return;
+    }
+    auto it = node->children.find(component);
+    if (it == node->children.end()) {
+      found = false;
+      return;
+    }
+    node = &nodes[it->second];
+  });
+  return found ? node : nullptr;
+}
+
+/// Rebuild the pre-order ranges if vertices have been added since they were
+/// last built.
+void NameIndex::updateRanges() const {
+  std::lock_guard<std::mutex> lock(rangesMutex);
+  if (rangesValid) {
+    return;
+  }
+  ranges.assign(nodes.size(), Range{0, 0, 0, 0});
+  rangeVertices.clear();
+  rangeVertices.reserve(blobVertices.size());
+  uint32_t position = 0;
+  buildRanges(0, position);
+  rangesValid = true;
+}
+
+/// Number the nodes of a subtree in pre-order, appending their vertices.
+void NameIndex::buildRanges(uint32_t node, uint32_t &position) const {
+  auto &range = ranges[node];
+  range.first = position++;
+  rangeVertices.insert(std::end(rangeVertices),
+                       std::begin(nodes[node].vertices),
+                       std::end(nodes[node].vertices));
+  range.vertexBegin = rangeVertices.size();
+  for (auto &child : nodes[node].children) {
+    buildRanges(child.second, position);
+  }
+  range.last = position;
+  range.vertexEnd = rangeVertices.size();
+}
+
+VertexIDVec NameIndex::getVerticesInScope(const std::string &scope) const {
+  VertexIDVec result;
+  auto node = findScope(scope);
+  if (node != NULL_NODE) {
+    auto &range = ranges[node];
+    result.assign(std::begin(rangeVertices) + range.vertexBegin,
+                  std::begin(rangeVertices) + range.vertexEnd);
+    std::sort(std::begin(result), std::end(result));
+  }
+  return result;
+}
+
+std::vector<std::string>
+NameIndex::getChildScopes(const std::string &scope) const {
+  std::vector<std::string> result;
+  auto node = findNode(scope);
+  if (node) {
+    for (auto &child : node->children) {
+      if (!nodes[child.second].children.empty()) {
+        result.push_back(child.first);
+      }
+    }
+  }
+  return result;
+}
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <boost/algorithm/string/replace.hpp>
+#include "netlist_paths/Exception.hpp"
+#include "netlist_paths/NameMatcher.hpp"
+
+using namespace netlist_paths;
+
+NameMatcher::NameMatcher(const std::string &pattern,
+                         bool wildcard,
+                         bool separatorsAsAny) {
+  useRegex = !compile(pattern, wildcard, separatorsAsAny);
+  if (!useRegex) {
+    determineSegmentsLiteral();
+    return;
+  }
+  auto regexStr(pattern);
+  if (separatorsAsAny) {
+    // Ignoring '/' (when supplying a heirarchical ref).
+    std::replace(regexStr.begin(), regexStr.end(), '/', '.');
+    // Or '_' (when supplying a flattened name).
+    std::replace(regexStr.begin(), regexStr.end(), '_', '.');
+  }
+  // Wildcard matching.
+  if (wildcard) {
+    boost::replace_all(regexStr, "?", ".");
+    boost::replace_all(regexStr, "*", ".*");
+  }
+  // Catch any errors in the regex string.
+  try {
+    regex.assign(regexStr);
+  } catch(std::regex_error &e) {
+    throw Exception(std::string("malformed regular expression: ")+e.what());
+  }
+  requiredLiteral = determineRegexLiteral(regexStr);
+}
+
+/// Find the longest run of literal characters in the segments.
+void NameMatcher::determineSegmentsLiteral() {
+  for (auto &segment : segments) {
+    std::size_t begin = 0;
+    while (begin < segment.chars.size()) {
+      auto end = segment.chars.find(ANY, begin);
+      if (end == std::string::npos) {
+        end = segment.chars.size();
+      }
+      if (end - begin > requiredLiteral.size()) {
+        requiredLiteral = segment.chars.substr(begin, end - begin);
+      }
+      begin = end + 1;
+    }
+  }
+}
+
+/// Find the longest run of literal characters that any match of a regex must
+/// contain. Runs are ended by any other syntax; characters made optional by
+/// a following quantifier and anything inside groups or character classes
+/// are excluded, and no literal is required if there is an alternation.
+std::string NameMatcher::determineRegexLiteral(const std::string &regexStr) {
+  std::string best;
+  std::string current;
+  auto flush = [&]() {
+    if (current.size() > best.size()) {
+      best = current;
+    }
+    current.clear();
+  };
+  if (regexStr.find_first_of("|\n") != std::string::npos) {
+    return std::string();
+  }
+  int depth = 0;
+  for (std::size_t i = 0; i < regexStr.size(); ++i) {
+    auto c = regexStr[i];
+    if (c == '\\') {
+      if (++i == regexStr.size()) {
+        break;
+      }
+      auto escaped = regexStr[i];
+      if (depth > 0 || std::isalnum(static_cast<unsigned char>(escaped))) {
+        // Character classes, assertions, back references and character
+        // codes, whose digits are skipped.
+        flush();
+        if (std::strchr("xuc0123456789", escaped)) {
+          while (i + 1 < regexStr.size() &&
+                 std::isalnum(static_cast<unsigned char>(regexStr[i + 1]))) {
+            i++;
+          }
+        }
+      } else {
+        current.push_back(escaped);
+      }
+    } else if (c == '[') {
+      flush();
+      // Skip the class.
+      while (++i < regexStr.size() && regexStr[i] != ']') {
+        if (regexStr[i] == '\\') {
+          i++;
+        }
+      }
+    } else if (c == '(') {
+      flush();
+      depth++;
+    } else if (c == ')') {
+      flush();
+      depth--;
+    } else if (c == '*' || c == '?' || c == '{') {
+      // The previous character may not occur.
+      if (!current.empty()) {
+        current.pop_back();
+      }
+      flush();
+      if (c == '{') {
+        while (i < regexStr.size() && regexStr[i] != '}') {
+          i++;
+        }
+      }
+    } else if (c == '+') {
+      // The previous character occurs, unless a further quantifier follows.
+      if (i + 1 < regexStr.size() && std::strchr("*?{", regexStr[i + 1]) &&
+          !current.empty()) {
+        current.pop_back();
+      }
+      flush();
+    } else if (c == '.' || c == '^' || c == '$' || depth > 0) {
+      flush();
+    } else {
+      current.push_back(c);
+    }
+  }
+  flush();
+  return best;
+}
+
+/// Split a pattern into segments, returning false if it contains regex
+/// syntax that cannot be matched directly.
+bool NameMatcher::compile(const std::string &pattern,
+                          bool wildcard,
+                          bool separatorsAsAny) {
+  std::size_t begin = 0;
+  std::size_t end = pattern.size();
+  anchorStart = begin < end && pattern[begin] == '^';
+  if (anchorStart) {
+    begin++;
+  }
+  anchorEnd = begin < end && pattern[end - 1] == '$';
+  if (anchorEnd) {
+    end--;
+  }
+  segments.push_back({"", false});
+  auto addAny = [this]() {
+    segments.back().chars.push_back(ANY);
+    segments.back().hasAny = true;
+  };
+  for (auto i = begin; i < end; ++i) {
+    auto c = pattern[i];
+    if (separatorsAsAny && (c == '/' || c == '_')) {
+      addAny();
+    } else if (wildcard && (c == '.' || c == '?')) {
+      addAny();
+    } else if (wildcard && c == '*') {
+      segments.push_back({"", false});
+    } else if (!wildcard && c == '*' && !segments.back().chars.empty() &&
+               segments.back().chars.back() == ANY) {
+      // An any character repeated is an any sequence.
+      segments.back().chars.pop_back();
+      segments.push_back({"", false});
+    } else if (!wildcard && c == '.') {
+      addAny();
+    } else if (c == '\0' || std::strchr("\\^$.|?*+()[]{}", c)) {
+      return false;
+    } else {
+      segments.back().chars.push_back(c);
+    }
+  }
+  return true;
+}
+
+/// Return true if a segment matches a name at a position.
+bool NameMatcher::matchAt(const std::string &name,
+                          std::size_t pos,
+                          const Segment &segment) {
+  if (!segment.hasAny) {
+    return name.compare(pos, segment.chars.size(), segment.chars) == 0;
+  }
+  for (std::size_t i = 0; i < segment.chars.size(); ++i) {
+    if (segment.chars[i] != ANY && segment.chars[i] != name[pos + i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Return the first position at or after pos that a segment matches a name,
+/// or npos.
+std::size_t NameMatcher::find(const std::string &name,
+                              std::size_t pos,
+                              const Segment &segment) {
+  if (!segment.hasAny) {
+    return name.find(segment.chars, pos);
+  }
+  if (name.size() < segment.chars.size()) {
+    return std::string::npos;
+  }
+  for (; pos <= name.size() - segment.chars.size(); ++pos) {
+    if (matchAt(name, pos, segment)) {
+      return pos;
+    }
+  }
+  return std::string::npos;
+}
+
+bool NameMatcher::match(const std::string &name) const {
+  if (useRegex) {
+    return std::regex_search(name, regex);
+  }
+  auto &first = segments.front();
+  auto &last = segments.back();
+  if (segments.size() == 1) {
+    if (name.size() < first.chars.size()) {
+      return false;
+    }
+    if (anchorStart && anchorEnd) {
+      return name.size() == first.chars.size() && matchAt(name, 0, first);
+    }
+    if (anchorStart) {
+      return matchAt(name, 0, first);
+    }
+    if (anchorEnd) {
+      return matchAt(name, name.size() - first.chars.size(), first);
+    }
+    return find(name, 0, first) != std::string::npos;
+  }
+  // Match the first segment at the start or as early as possible, each middle
+  // segment as early as possible after the previous one, and the last segment
+  // at the end or anywhere after the previous one.
+  std::size_t pos;
+  if (anchorStart) {
+    if (name.size() < first.chars.size() || !matchAt(name, 0, first)) {
+      return false;
+    }
+    pos = first.chars.size();
+  } else {
+    pos = find(name, 0, first);
+    if (pos == std::string::npos) {
+      return false;
+    }
+    pos += first.chars.size();
+  }
+  for (std::size_t i = 1; i + 1 < segments.size(); ++i) {
+    pos = find(name, pos, segments[i]);
+    if (pos == std::string::npos) {
+      return false;
+    }
+    pos += segments[i].chars.size();
+  }
+  if (anchorEnd) {
+    return name.size() - pos >= last.chars.size() &&
+           matchAt(name, name.size() - last.chars.size(), last);
+  }
+  return find(name, pos, last) != std::string::npos;
+}
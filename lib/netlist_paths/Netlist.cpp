@@ -1,39 +1,56 @@
-#include <regex>
+#include <algorithm>
+#include <iterator>
+#include <map>
 #include <boost/format.hpp>
+#include "netlist_paths/NameMatcher.hpp"
 #include "netlist_paths/Netlist.hpp"
+#include "netlist_paths/RegisterGraph.hpp"
 
 using namespace netlist_paths;
 
-/// Return a list of IDs of named vertices, optionally filter by regex.
+/// Return a list of IDs of named vertices in name order, optionally filtered
+/// by regex.
 std::vector<VertexID>
 Netlist::getNamedVertexIds(const std::string &regex) const {
+  if (regex.empty()) {
+    return netlist.getNameOrder().vertices;
+  }
   std::vector<VertexID> vertices;
-  std::regex nameRegex(regex);
-  for (auto vertexId : netlist.getAllVertices()) {
-    if (netlist.getVertex(vertexId).isNamed() &&
-        (regex.empty() ||
-         std::regex_search(netlist.getVertex(vertexId).getName(), nameRegex))) {
+  netlist.forEachNameMatch(NameMatcher(regex, false, false),
+                           [&](VertexID vertexId) {
+    if (netlist.getVertex(vertexId).isNamed()) {
       vertices.push_back(vertexId);
     }
-  }
+    return true;
+  });
+  netlist.sortByName(vertices);
   return vertices;
 }
 
 /// Return a sorted list of unique named entities in the netlist for searching.
 std::vector<std::reference_wrapper<const Vertex>>
 Netlist::getNamedVertices(const std::string &regex) const {
-  // Collect vertices.
   std::vector<std::reference_wrapper<const Vertex>> vertices;
   for (auto vertexId : getNamedVertexIds(regex)) {
     vertices.push_back(std::ref(netlist.getVertex(vertexId)));
   }
-  // Sort them.
-  auto compare = [](const Vertex& a, const Vertex& b) {
-                   return a.compareLessThan(b); };
-  std::sort(vertices.begin(), vertices.end(), compare);
   return vertices;
 }
 
+/// Return up to count named vertices whose names start with a prefix, in name
+/// order, skipping the first offset of them.
+std::vector<Vertex*>
+Netlist::getNamedVerticesPage(const std::string &prefix,
+                              std::size_t offset,
+                              std::size_t count) const {
+  auto &order = netlist.getNameOrder();
+  auto range = netlist.getNamePrefixRange(prefix);
+  auto begin = std::min(range.first + offset, range.second);
+  auto end = begin + std::min(count, range.second - begin);
+  return createVertexPtrVec(VertexIDVec(std::begin(order.vertices) + begin,
+                                        std::begin(order.vertices) + end));
+}
+
 VertexIDVec Netlist::readWaypoints(Waypoints waypoints) const {
   VertexIDVec waypointIDs;
   for (auto it = waypoints.begin(); it != waypoints.end(); ++it) {
@@ -61,3 +78,301 @@ VertexIDVec Netlist::readWaypoints(Waypoints waypoints) const {
   }
   return waypointIDs;
 }
+
+/// Mark the vertices matching each avoid point of a set of waypoints. The
+/// result is empty if there are no avoid points.
+std::vector<bool> Netlist::readAvoidPoints(const Waypoints &waypoints) const {
+  return readAvoidPoints(waypoints.getAvoidPoints());
+}
+
+/// Mark the vertices matching each of a list of avoid points. The result is
+/// empty if there are no avoid points.
+std::vector<bool>
+Netlist::readAvoidPoints(const std::vector<std::string> &avoidPoints) const {
+  std::vector<bool> avoid;
+  if (avoidPoints.empty()) {
+    return avoid;
+  }
+  avoid.assign(netlist.numVertices(), false);
+  for (auto &name : avoidPoints) {
+    auto vertices = netlist.getVerticesRegex(name);
+    if (vertices.empty()) {
+      throw Exception(std::string("could not find avoid vertex "+name));
+    }
+    for (auto vertex : vertices) {
+      avoid[vertex] = true;
+    }
+  }
+  return avoid;
+}
+
+std::vector<bool>
+Netlist::pathsExist(std::vector<Waypoints> waypointsList) const {
+  std::vector<bool> result(waypointsList.size(), false);
+  std::vector<VertexIDPair> pairs;
+  std::vector<std::size_t> pairIndexes;
+  // Resolve each distinct start and finish name once.
+  std::map<std::string, VertexID> startVertices;
+  std::map<std::string, VertexID> finishVertices;
+  auto lookup = [this](std::map<std::string, VertexID> &cache,
+                       const std::string &name,
+                       VertexGraphType graphType) {
+    auto it = cache.find(name);
+    if (it == cache.end()) {
+      it = cache.emplace(name, netlist.getVertexDescRegex(name, graphType)).first;
+    }
+    return it->second;
+  };
+  for (std::size_t i = 0; i < waypointsList.size(); ++i) {
+    auto &waypoints = waypointsList[i];
+    if (waypoints.size() != 2 || !waypoints.getAvoidPoints().empty()) {
+      // Through and avoid points are handled individually.
+      result[i] = pathExists(waypoints);
+      continue;
+    }
+    auto startName = *waypoints.begin();
+    auto finishName = *(waypoints.begin()+1);
+    auto startVertex = lookup(startVertices, startName,
+                              VertexGraphType::START_POINT);
+    if (startVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find start vertex "+startName));
+    }
+    auto finishVertex = lookup(finishVertices, finishName,
+                               VertexGraphType::END_POINT);
+    if (finishVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find end vertex "+finishName));
+    }
+    pairs.push_back(std::make_pair(startVertex, finishVertex));
+    pairIndexes.push_back(i);
+  }
+  auto reachabilityIndex = getReachabilityIndex();
+  if (reachabilityIndex) {
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+      result[pairIndexes[i]] = reachabilityIndex->reachable(pairs[i].first,
+                                                            pairs[i].second);
+    }
+    return result;
+  }
+  auto reachable = netlist.getPointToPointReachability(pairs);
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    result[pairIndexes[i]] = reachable[i];
+  }
+  return result;
+}
+
+Netlist::PathMatrix
+Netlist::getPathMatrix(const std::string &startPattern,
+                       const std::string &finishPattern,
+                       bool withPaths,
+                       const std::vector<std::string> &avoidPoints) const {
+  auto matches = netlist.getVerticesRegex(
+      {{startPattern, VertexGraphType::START_POINT},
+       {finishPattern, VertexGraphType::END_POINT}});
+  auto &startVertices = matches[0];
+  auto &finishVertices = matches[1];
+  if (startVertices.empty()) {
+    throw Exception(std::string("could not find start vertex "+startPattern));
+  }
+  if (finishVertices.empty()) {
+    throw Exception(std::string("could not find end vertex "+finishPattern));
+  }
+  PathMatrix matrix;
+  matrix.startPoints = createVertexPtrVec(startVertices);
+  matrix.finishPoints = createVertexPtrVec(finishVertices);
+  auto avoid = readAvoidPoints(avoidPoints);
+  // The index does not account for avoid points.
+  auto reachabilityIndex = getReachabilityIndex();
+  if (reachabilityIndex && avoid.empty()) {
+    matrix.connected.assign(startVertices.size(),
+                            std::vector<bool>(finishVertices.size(), false));
+    for (std::size_t i = 0; i < startVertices.size(); ++i) {
+      for (std::size_t j = 0; j < finishVertices.size(); ++j) {
+        matrix.connected[i][j] =
+            reachabilityIndex->reachable(startVertices[i], finishVertices[j]);
+      }
+    }
+  } else {
+    matrix.connected = netlist.getReachabilityMatrix(startVertices,
+                                                     finishVertices, avoid);
+  }
+  if (withPaths) {
+    auto paths = netlist.getMatrixPaths(startVertices, finishVertices,
+                                        matrix.connected, avoid);
+    for (auto &row : paths) {
+      matrix.paths.push_back(createVertexPtrVecVec(row));
+    }
+  }
+  return matrix;
+}
+
+Netlist::PathArrays
+Netlist::createPathArrays(const std::vector<VertexIDVec> &paths) {
+  PathArrays arrays;
+  arrays.offsets.reserve(paths.size() + 1);
+  arrays.offsets.push_back(0);
+  for (auto &path : paths) {
+    arrays.vertices.insert(std::end(arrays.vertices),
+                           std::begin(path), std::end(path));
+    arrays.offsets.push_back(arrays.vertices.size());
+  }
+  return arrays;
+}
+
+Netlist::VertexTable Netlist::getVertexTable() const {
+  VertexTable table;
+  auto numVertices = netlist.numVertices();
+  table.astTypes.reserve(numVertices);
+  table.directions.reserve(numVertices);
+  table.widths.reserve(numVertices);
+  table.nameOffsets.reserve(numVertices + 1);
+  table.nameOffsets.push_back(0);
+  for (VertexID vertex = 0; vertex < numVertices; ++vertex) {
+    auto &v = netlist.getVertex(vertex);
+    table.astTypes.push_back(static_cast<uint8_t>(v.getAstType()));
+    table.directions.push_back(static_cast<uint8_t>(v.getDirection()));
+    table.widths.push_back(static_cast<uint32_t>(v.getDTypeWidth()));
+    table.names.append(v.getName());
+    table.nameOffsets.push_back(table.names.size());
+  }
+  return table;
+}
+
+std::vector<std::vector<std::vector<Vertex*> > >
+Netlist::getAllFanOutMulti(const std::vector<std::string> &startNames,
+                           const std::vector<std::string> &avoidPoints) const {
+  VertexIDVec startVertices;
+  for (auto &name : startNames) {
+    auto startVertex = netlist.getStartVertex(name);
+    if (startVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find start vertex "+name));
+    }
+    startVertices.push_back(startVertex);
+  }
+  std::vector<std::vector<std::vector<Vertex*> > > result;
+  for (auto &paths : netlist.getAllFanOut(startVertices,
+                                          readAvoidPoints(avoidPoints))) {
+    result.push_back(createVertexPtrVecVec(paths));
+  }
+  return result;
+}
+
+std::vector<std::vector<std::vector<Vertex*> > >
+Netlist::getAllFanInMulti(const std::vector<std::string> &finishNames,
+                          const std::vector<std::string> &avoidPoints) const {
+  VertexIDVec finishVertices;
+  for (auto &name : finishNames) {
+    auto finishVertex = netlist.getEndVertex(name);
+    if (finishVertex == netlist.nullVertex()) {
+      throw Exception(std::string("could not find finish vertex "+name));
+    }
+    finishVertices.push_back(finishVertex);
+  }
+  std::vector<std::vector<std::vector<Vertex*> > > result;
+  for (auto &paths : netlist.getAllFanIn(finishVertices,
+                                         readAvoidPoints(avoidPoints))) {
+    result.push_back(createVertexPtrVecVec(paths));
+  }
+  return result;
+}
+
+int Netlist::getLogicDepth(const std::string &finishName) const {
+  auto finishVertex = netlist.getEndVertex(finishName);
+  if (finishVertex == netlist.nullVertex()) {
+    throw Exception(std::string("could not find finish vertex "+finishName));
+  }
+  return netlist.getLogicDepth().getDepth(finishVertex);
+}
+
+std::vector<std::pair<Vertex*, std::size_t> >
+Netlist::getAllLogicDepths() const {
+  return createVertexPtrCountVec(netlist.getLogicDepth().getFinishDepths());
+}
+
+std::vector<std::vector<Vertex*> >
+Netlist::getDeepestPaths(std::size_t k) const {
+  auto &logicDepth = netlist.getLogicDepth();
+  std::vector<VertexIDVec> paths;
+  for (auto &entry : logicDepth.getDeepest(k)) {
+    paths.push_back(logicDepth.getPath(entry.first));
+  }
+  return createVertexPtrVecVec(paths);
+}
+
+std::unique_ptr<Netlist>
+Netlist::extractCone(const std::vector<std::string> &names,
+                     bool fanIn, bool fanOut) const {
+  // Find a root vertex for each name in each direction, preferring finish
+  // points for fan in and start points for fan out.
+  auto getRoots = [&](bool reverse) {
+    VertexIDVec roots;
+    for (auto &name : names) {
+      auto vertex = reverse ? netlist.getEndVertex(name)
+                            : netlist.getStartVertex(name);
+      if (vertex == netlist.nullVertex()) {
+        vertex = netlist.getMidVertex(name);
+      }
+      if (vertex == netlist.nullVertex()) {
+        throw Exception(std::string("could not find vertex "+name));
+      }
+      roots.push_back(vertex);
+    }
+    return roots;
+  };
+  VertexIDVec vertices;
+  if (fanIn) {
+    vertices = netlist.getCone(getRoots(true), true);
+  }
+  if (fanOut) {
+    auto fanOutCone = netlist.getCone(getRoots(false), false);
+    VertexIDVec cone;
+    std::set_union(std::begin(vertices), std::end(vertices),
+                   std::begin(fanOutCone), std::end(fanOutCone),
+                   std::back_inserter(cone));
+    vertices.swap(cone);
+  }
+  return std::unique_ptr<Netlist>(new Netlist(*this, vertices));
+}
+
+/// Return the registers and output ports that a start point fans out to
+/// through combinational logic.
+std::vector<Vertex*>
+Netlist::getRegisterFanOut(const std::string &startName) const {
+  auto startVertex = netlist.getStartVertex(startName);
+  if (startVertex == netlist.nullVertex()) {
+    throw Exception(std::string("could not find start vertex "+startName));
+  }
+  auto &registerGraph = netlist.getRegisterGraph();
+  std::vector<Vertex*> result;
+  for (auto node : registerGraph.getFanOut(registerGraph.getNode(startVertex))) {
+    result.push_back(netlist.getVertexPtr(registerGraph.getNode(node).finishVertex));
+  }
+  return result;
+}
+
+/// Return the registers and input ports that fan in to a finish point through
+/// combinational logic.
+std::vector<Vertex*>
+Netlist::getRegisterFanIn(const std::string &finishName) const {
+  auto finishVertex = netlist.getEndVertex(finishName);
+  if (finishVertex == netlist.nullVertex()) {
+    throw Exception(std::string("could not find finish vertex "+finishName));
+  }
+  auto &registerGraph = netlist.getRegisterGraph();
+  std::vector<Vertex*> result;
+  for (auto node : registerGraph.getFanIn(registerGraph.getNode(finishVertex))) {
+    result.push_back(netlist.getVertexPtr(registerGraph.getNode(node).startVertex));
+  }
+  return result;
+}
+
+/// Return the minimum number of registers on any path from an input port to
+/// a finish point, including the finish point itself if it is a register, or
+/// -1 if the finish point is not reachable from an input port.
+int Netlist::getPipelineDepth(const std::string &name) const {
+  auto finishVertex = netlist.getEndVertex(name);
+  if (finishVertex == netlist.nullVertex()) {
+    throw Exception(std::string("could not find finish vertex "+name));
+  }
+  auto &registerGraph = netlist.getRegisterGraph();
+  return registerGraph.getPipelineDepths()[registerGraph.getNode(finishVertex)];
+}
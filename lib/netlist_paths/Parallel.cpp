@@ -0,0 +1,67 @@
+#include "netlist_paths/Parallel.hpp"
+
+using namespace netlist_paths;
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+/// Run tasks of the queued jobs, in the order the jobs were queued, until the
+/// pool is destroyed.
+void ThreadPool::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+    if (stopping) {
+      return;
+    }
+    auto job = jobs.front();
+    auto index = job->next++;
+    if (job->next == job->end) {
+      jobs.pop_front();
+    }
+    ++job->running;
+    lock.unlock();
+    (*job->task)(index);
+    lock.lock();
+    if (--job->running == 0) {
+      job->finished.notify_all();
+    }
+  }
+}
+
+void ThreadPool::run(unsigned numTasks,
+                     const std::function<void(unsigned)> &task) {
+  if (numTasks <= 1) {
+    task(0);
+    return;
+  }
+  Job job;
+  job.task = &task;
+  job.next = 1;
+  job.end = numTasks;
+  job.running = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(&job);
+    while (threads.size() < numTasks - 1) {
+      threads.emplace_back(&ThreadPool::work, this);
+    }
+  }
+  wake.notify_all();
+  task(0);
+  // Withdraw the tasks no thread has started and wait for the others.
+  std::unique_lock<std::mutex> lock(mutex);
+  if (job.next != job.end) {
+    job.end = job.next;
+    jobs.erase(std::find(std::begin(jobs), std::end(jobs), &job));
+  }
+  job.finished.wait(lock, [&job] { return job.running == 0; });
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include "netlist_paths/PathEnumerator.hpp"
+#include "netlist_paths/TraversalCache.hpp"
+
+using namespace netlist_paths;
+
+FanPathEnumerator::FanPathEnumerator(const Graph &graph,
+                                     std::shared_ptr<const TraversalTree> tree) :
+    graph(graph), tree(std::move(tree)), position(this->tree->begin()) {}
+
+bool FanPathEnumerator::next(VertexIDVec &path) {
+  auto root = tree->getRoot();
+  auto reverse = tree->isReverse();
+  for (; position != tree->end(); ++position) {
+    auto v = position->first;
+    auto &vertex = graph.getVertex(v);
+    if (reverse ? vertex.isStartPoint() : vertex.isFinishPoint()) {
+      break;
+    }
+  }
+  if (position == tree->end()) {
+    return false;
+  }
+  auto v = (position++)->first;
+  path.assign({v});
+  for (auto u = v; u != root; u = tree->getParent(u)) {
+    path.push_back(tree->getParent(u));
+  }
+  if (!reverse) {
+    std::reverse(std::begin(path), std::end(path));
+  }
+  return true;
+}
+
+AllPathsEnumerator::AllPathsEnumerator(ParentMap parentMap,
+                                       VertexID startVertex,
+                                       VertexID finishVertex) :
+    parentMap(std::move(parentMap)),
+    startVertex(startVertex),
+    finishVertex(finishVertex),
+    started(false) {}
+
+bool AllPathsEnumerator::next(VertexIDVec &path) {
+  if (!started) {
+    started = true;
+    if (finishVertex == startVertex) {
+      path.assign({startVertex});
+      return true;
+    }
+    stack.push_back(finishVertex);
+    indexes.push_back(0);
+  }
+  while (!stack.empty()) {
+    auto &parents = parentMap[stack.back()];
+    auto &index = indexes.back();
+    if (index == parents.size()) {
+      // All the paths through this vertex have been visited.
+      stack.pop_back();
+      indexes.pop_back();
+      continue;
+    }
+    auto vertex = parents[index++];
+    if (std::find(std::begin(stack), std::end(stack), vertex) != std::end(stack)) {
+      // Cycle.
+      continue;
+    }
+    if (vertex == startVertex) {
+      path.assign(stack.rbegin(), stack.rend());
+      path.insert(std::begin(path), startVertex);
+      return true;
+    }
+    stack.push_back(vertex);
+    indexes.push_back(0);
+  }
+  return false;
+}
@@ -0,0 +1,65 @@
+#include <vector>
+#include "netlist_paths/Exception.hpp"
+#include "netlist_paths/QueryContext.hpp"
+
+using namespace netlist_paths;
+
+/// The contexts entered on each thread, innermost last.
+static thread_local std::vector<QueryContext*> enteredContexts;
+
+QueryContext::QueryContext() :
+    debugMode(Options::getInstance().debugMode),
+    verboseMode(Options::getInstance().verboseMode),
+    matchWildcard(Options::getInstance().matchWildcard),
+    numThreads(Options::getInstance().numThreads),
+    bfsThreshold(Options::getInstance().bfsThreshold),
+    traversalCacheSize(Options::getInstance().traversalCacheSize) {}
+
+QueryContext::QueryContext(const QueryContext &other) :
+    debugMode(other.debugMode),
+    verboseMode(other.verboseMode),
+    matchWildcard(other.matchWildcard),
+    numThreads(other.numThreads),
+    bfsThreshold(other.bfsThreshold),
+    traversalCacheSize(other.traversalCacheSize) {}
+
+QueryContext &QueryContext::operator=(const QueryContext &other) {
+  debugMode = other.debugMode;
+  verboseMode = other.verboseMode;
+  matchWildcard = other.matchWildcard;
+  numThreads = other.numThreads;
+  bfsThreshold = other.bfsThreshold;
+  traversalCacheSize = other.traversalCacheSize;
+  return *this;
+}
+
+void QueryContext::enter() {
+  enteredContexts.push_back(this);
+}
+
+void QueryContext::exit() {
+  if (enteredContexts.empty() || enteredContexts.back() != this) {
+    throw Exception("query context exited without being entered");
+  }
+  enteredContexts.pop_back();
+}
+
+/// Return the innermost context entered on the calling thread or, if there is
+/// none, the thread's default context. The default context is created once
+/// per thread and updated only when the global options have changed.
+QueryContext &QueryContext::current() {
+  if (!enteredContexts.empty()) {
+    return *enteredContexts.back();
+  }
+  // Read the generation before the options, so a change made in between is
+  // picked up by the next call.
+  static thread_local unsigned optionsGeneration =
+      Options::getInstance().getGeneration();
+  static thread_local QueryContext defaultContext;
+  auto generation = Options::getInstance().getGeneration();
+  if (generation != optionsGeneration) {
+    optionsGeneration = generation;
+    defaultContext = QueryContext();
+  }
+  return defaultContext;
+}
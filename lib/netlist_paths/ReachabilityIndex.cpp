@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <boost/graph/iteration_macros.hpp>
+#include "netlist_paths/Condensation.hpp"
+#include "netlist_paths/Debug.hpp"
+#include "netlist_paths/Exception.hpp"
+#include "netlist_paths/Options.hpp"
+#include "netlist_paths/ReachabilityIndex.hpp"
+
+using namespace netlist_paths;
+
+constexpr const char *INDEX_FILE_MAGIC = "NPRI";
+constexpr uint32_t INDEX_FILE_VERSION = 1;
+
+template<typename T>
+static void writeValue(std::ofstream &file, const T &value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void readValue(std::ifstream &file, T &value) {
+  file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void writeVector(std::ofstream &file, const std::vector<T> &values) {
+  writeValue(file, static_cast<uint64_t>(values.size()));
+  file.write(reinterpret_cast<const char*>(values.data()),
+             values.size() * sizeof(T));
+}
+
+/// Read a vector, failing the stream if its length exceeds the data remaining
+/// in the file.
+template<typename T>
+static void readVector(std::ifstream &file, std::vector<T> &values,
+                       uint64_t fileSize) {
+  uint64_t size = 0;
+  readValue(file, size);
+  auto position = file.tellg();
+  if (!file || position < 0 ||
+      size > (fileSize - static_cast<uint64_t>(position)) / sizeof(T)) {
+    file.setstate(std::ios::failbit);
+    return;
+  }
+  values.resize(size);
+  file.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+}
+
+/// Compute an FNV-1a hash of the edges of a graph, used to check that a
+/// saved index corresponds to a netlist.
+uint64_t ReachabilityIndex::hashEdges(const Graph &graph) {
+  uint64_t hash = 14695981039346656037ULL;
+  auto combine = [&hash](uint64_t value) {
+    for (unsigned i = 0; i < 8; ++i) {
+      hash ^= (value >> (i * 8)) & 0xff;
+      hash *= 1099511628211ULL;
+    }
+  };
+  BGL_FORALL_EDGES(e, graph.graph, InternalGraph) {
+    combine(boost::source(e, graph.graph));
+    combine(boost::target(e, graph.graph));
+  }
+  return hash;
+}
+
+ReachabilityIndex::ReachabilityIndex(const Graph &graph) :
+    numVertices(graph.numVertices()),
+    numEdges(graph.numEdges()),
+    edgeHash(hashEdges(graph)) {
+  INFO(std::cout << "Building reachability index\n");
+  auto &sccs = graph.getCondensation();
+  numComponents = sccs.getNumComponents();
+  components = sccs.getComponents();
+  dagOffsets = sccs.getDAGOffsets();
+  dagEdges = sccs.getDAGEdges();
+  if (numComponents <= MAX_CLOSURE_COMPONENTS) {
+    buildClosure();
+  } else {
+    buildLabels();
+  }
+  INFO(std::cout << "Reachability index contains " << numComponents
+                 << " components and " << dagEdges.size() << " edges\n");
+}
+
+ReachabilityIndex::ReachabilityIndex(const Graph &graph,
+                                     const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw Exception(std::string("unable to open ")+filename);
+  }
+  auto fileSize = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+  char magic[4];
+  uint32_t version = 0;
+  file.read(magic, sizeof(magic));
+  readValue(file, version);
+  if (!file || !std::equal(magic, magic + sizeof(magic), INDEX_FILE_MAGIC) ||
+      version != INDEX_FILE_VERSION) {
+    throw Exception(std::string("invalid reachability index file ")+filename);
+  }
+  readValue(file, numVertices);
+  readValue(file, numEdges);
+  readValue(file, edgeHash);
+  readValue(file, numComponents);
+  if (!file ||
+      numVertices != graph.numVertices() ||
+      numEdges != graph.numEdges() ||
+      edgeHash != hashEdges(graph)) {
+    throw Exception(std::string("reachability index ")+filename+
+                    " does not match the netlist");
+  }
+  readVector(file, components, fileSize);
+  readVector(file, dagOffsets, fileSize);
+  readVector(file, dagEdges, fileSize);
+  readVector(file, closure, fileSize);
+  readVector(file, labels, fileSize);
+  if (!file) {
+    throw Exception(std::string("truncated reachability index file ")+filename);
+  }
+  if (!isConsistent()) {
+    throw Exception(std::string("invalid reachability index file ")+filename);
+  }
+  INFO(std::cout << "Loaded reachability index with " << numComponents
+                 << " components\n");
+}
+
+/// Write the index to a file.
+void ReachabilityIndex::save(const std::string &filename) const {
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw Exception(std::string("unable to open ")+filename);
+  }
+  file.write(INDEX_FILE_MAGIC, 4);
+  writeValue(file, INDEX_FILE_VERSION);
+  writeValue(file, numVertices);
+  writeValue(file, numEdges);
+  writeValue(file, edgeHash);
+  writeValue(file, numComponents);
+  writeVector(file, components);
+  writeVector(file, dagOffsets);
+  writeVector(file, dagEdges);
+  writeVector(file, closure);
+  writeVector(file, labels);
+  file.close();
+  if (!file) {
+    throw Exception(std::string("unable to write ")+filename);
+  }
+}
+
+/// Return true if the sizes of the loaded tables agree with each other and
+/// every component number and offset is in range, so that queries cannot
+/// index outside the tables.
+bool ReachabilityIndex::isConsistent() const {
+  if (numComponents > numVertices ||
+      numComponents > std::numeric_limits<uint32_t>::max() ||
+      components.size() != numVertices ||
+      dagOffsets.size() != numComponents + 1) {
+    return false;
+  }
+  bool closureValid = closure.size() == numComponents * closureWords() &&
+                      labels.empty();
+  bool labelsValid = labels.size() == numComponents * NUM_LABELS &&
+                     closure.empty();
+  if (!closureValid && !labelsValid) {
+    return false;
+  }
+  for (auto component : components) {
+    if (component >= numComponents) {
+      return false;
+    }
+  }
+  if (dagOffsets.front() != 0 || dagOffsets.back() != dagEdges.size() ||
+      !std::is_sorted(std::begin(dagOffsets), std::end(dagOffsets))) {
+    return false;
+  }
+  // The condensed graph's edges only lead to later components.
+  for (std::size_t c = 0; c < numComponents; ++c) {
+    for (auto i = dagOffsets[c]; i < dagOffsets[c + 1]; ++i) {
+      if (dagEdges[i] <= c || dagEdges[i] >= numComponents) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Compute the transitive closure of the condensed graph. Since components
+/// are in topological order, visiting them in reverse means the closure of
+/// each successor is complete before it is used.
+void ReachabilityIndex::buildClosure() {
+  auto words = closureWords();
+  closure.assign(numComponents * words, 0);
+  for (std::size_t c = numComponents; c-- > 0;) {
+    auto row = &closure[c * words];
+    row[c / 64] |= uint64_t(1) << (c % 64);
+    for (auto i = dagOffsets[c]; i < dagOffsets[c + 1]; ++i) {
+      auto succRow = &closure[dagEdges[i] * words];
+      for (std::size_t w = 0; w < words; ++w) {
+        row[w] |= succRow[w];
+      }
+    }
+  }
+}
+
+/// Label each component with intervals [low, rank], where rank is the
+/// post-order number of the component in a randomised traversal and low is
+/// the smallest rank of any component reachable from it. If a component
+/// reaches another, its intervals contain those of the other.
+void ReachabilityIndex::buildLabels() {
+  struct Frame {
+    uint32_t component;
+    uint64_t offset;
+    uint64_t count;
+  };
+  labels.assign(numComponents * NUM_LABELS, Label());
+  std::vector<uint32_t> roots(numComponents);
+  std::iota(std::begin(roots), std::end(roots), 0);
+  std::vector<bool> visited(numComponents);
+  std::vector<Frame> stack;
+  for (std::size_t l = 0; l < NUM_LABELS; ++l) {
+    std::mt19937 random(l);
+    std::shuffle(std::begin(roots), std::end(roots), random);
+    std::fill(std::begin(visited), std::end(visited), false);
+    uint32_t rank = 0;
+    auto visit = [&](uint32_t c) {
+      visited[c] = true;
+      labels[c * NUM_LABELS + l].first = std::numeric_limits<uint32_t>::max();
+      auto degree = dagOffsets[c + 1] - dagOffsets[c];
+      stack.push_back({c, degree ? random() % degree : 0, 0});
+    };
+    for (auto root : roots) {
+      if (visited[root]) {
+        continue;
+      }
+      visit(root);
+      while (!stack.empty()) {
+        auto &frame = stack.back();
+        auto &label = labels[frame.component * NUM_LABELS + l];
+        auto begin = dagOffsets[frame.component];
+        auto degree = dagOffsets[frame.component + 1] - begin;
+        if (frame.count < degree) {
+          // Visit the successors starting from a random offset.
+          auto succ = dagEdges[begin + (frame.offset + frame.count) % degree];
+          frame.count++;
+          if (visited[succ]) {
+            label.first = std::min(label.first,
+                                   labels[succ * NUM_LABELS + l].first);
+          } else {
+            visit(succ);
+          }
+        } else {
+          label.second = rank++;
+          label.first = std::min(label.first, label.second);
+          auto low = label.first;
+          stack.pop_back();
+          if (!stack.empty()) {
+            auto &parentLabel = labels[stack.back().component * NUM_LABELS + l];
+            parentLabel.first = std::min(parentLabel.first, low);
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Return true if every label of dst is contained by the label of src.
+bool ReachabilityIndex::labelsContain(uint32_t src, uint32_t dst) const {
+  for (std::size_t l = 0; l < NUM_LABELS; ++l) {
+    auto &srcLabel = labels[src * NUM_LABELS + l];
+    auto &dstLabel = labels[dst * NUM_LABELS + l];
+    if (dstLabel.first < srcLabel.first || dstLabel.second > srcLabel.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Search the condensed graph, skipping any component that is after dst in
+/// topological order or whose labels show it cannot reach dst.
+bool ReachabilityIndex::searchDAG(uint32_t src, uint32_t dst) const {
+  std::vector<uint32_t> stack{src};
+  std::unordered_set<uint32_t> visited{src};
+  while (!stack.empty()) {
+    auto c = stack.back();
+    stack.pop_back();
+    for (auto i = dagOffsets[c]; i < dagOffsets[c + 1]; ++i) {
+      auto succ = dagEdges[i];
+      if (succ == dst) {
+        return true;
+      }
+      if (succ < dst &&
+          labelsContain(succ, dst) &&
+          visited.insert(succ).second) {
+        stack.push_back(succ);
+      }
+    }
+  }
+  return false;
+}
+
+/// Return true if a path exists between two vertices.
+bool ReachabilityIndex::reachable(VertexID startVertex,
+                                  VertexID finishVertex) const {
+  auto src = components[startVertex];
+  auto dst = components[finishVertex];
+  if (src == dst) {
+    return true;
+  }
+  if (src > dst) {
+    return false;
+  }
+  if (hasClosure()) {
+    return (closure[src * closureWords() + dst / 64] >> (dst % 64)) & 1;
+  }
+  if (!labelsContain(src, dst)) {
+    return false;
+  }
+  return searchDAG(src, dst);
+}
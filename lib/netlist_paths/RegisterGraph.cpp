@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <numeric>
+#include <boost/graph/iteration_macros.hpp>
+#include "netlist_paths/Debug.hpp"
+#include "netlist_paths/Options.hpp"
+#include "netlist_paths/Parallel.hpp"
+#include "netlist_paths/RegisterGraph.hpp"
+
+using namespace netlist_paths;
+
+RegisterGraph::RegisterGraph(const Graph &graph) : graph(graph) {
+  INFO(std::cout << "Building register graph\n");
+  determineNodes();
+  determineEdges();
+  determinePipelineDepths();
+  INFO(std::cout << "Register graph contains " << numNodes()
+                 << " nodes and " << numEdges() << " edges\n");
+}
+
+/// Create a node for each register, combining its source and destination
+/// vertices, and for each other start or finish point.
+void RegisterGraph::determineNodes() {
+  std::unordered_map<std::string, NodeID> regNodes;
+  BGL_FORALL_VERTICES(v, graph.graph, InternalGraph) {
+    auto &vertex = graph.graph[v];
+    auto isStart = vertex.isStartPoint();
+    auto isFinish = vertex.isFinishPoint();
+    if (!isStart && !isFinish) {
+      continue;
+    }
+    NodeID node = nodes.size();
+    if (vertex.isReg()) {
+      node = regNodes.emplace(vertex.getName(), nodes.size()).first->second;
+    }
+    if (node == nodes.size()) {
+      nodes.push_back({graph.nullVertex(), graph.nullVertex()});
+    }
+    if (isStart) {
+      nodes[node].startVertex = v;
+    }
+    if (isFinish) {
+      nodes[node].finishVertex = v;
+    }
+    vertexNodes[v] = node;
+  }
+}
+
+/// Determine the finish points reachable from each start point, with the
+/// start points distributed over a set of threads.
+void RegisterGraph::determineEdges() {
+  std::vector<NodeID> startNodes;
+  for (NodeID node = 0; node < nodes.size(); ++node) {
+    if (nodes[node].startVertex != graph.nullVertex()) {
+      startNodes.push_back(node);
+    }
+  }
+  // Per-thread visited marks (the index of the last start point to visit a
+  // vertex, to avoid clearing them) and stacks.
+  struct Scratch {
+    std::vector<std::size_t> visited;
+    VertexIDVec stack;
+  };
+  std::vector<Scratch> scratch(getNumThreads());
+  std::vector<std::vector<NodeID>> fanOut(nodes.size());
+  parallelFor(startNodes.size(), [&](std::size_t i, unsigned threadIndex) {
+    auto &visited = scratch[threadIndex].visited;
+    auto &stack = scratch[threadIndex].stack;
+    if (visited.empty()) {
+      visited.assign(graph.numVertices(), SIZE_MAX);
+    }
+    auto &successors = fanOut[startNodes[i]];
+    auto startVertex = nodes[startNodes[i]].startVertex;
+    visited[startVertex] = i;
+    stack.push_back(startVertex);
+    while (!stack.empty()) {
+      auto vertex = stack.back();
+      stack.pop_back();
+      BGL_FORALL_ADJ(vertex, adjVertex, graph.graph, InternalGraph) {
+        if (visited[adjVertex] != i) {
+          visited[adjVertex] = i;
+          stack.push_back(adjVertex);
+          if (graph.graph[adjVertex].isFinishPoint()) {
+            successors.push_back(vertexNodes.at(adjVertex));
+          }
+        }
+      }
+    }
+    std::sort(std::begin(successors), std::end(successors));
+    successors.erase(std::unique(std::begin(successors), std::end(successors)),
+                     std::end(successors));
+  });
+  // Compact the edges into fan out and fan in arrays.
+  fanOutOffsets.assign(nodes.size() + 1, 0);
+  fanInOffsets.assign(nodes.size() + 1, 0);
+  for (NodeID node = 0; node < nodes.size(); ++node) {
+    fanOutOffsets[node + 1] = fanOutOffsets[node] + fanOut[node].size();
+    for (auto succ : fanOut[node]) {
+      fanInOffsets[succ + 1]++;
+    }
+  }
+  std::partial_sum(std::begin(fanInOffsets), std::end(fanInOffsets),
+                   std::begin(fanInOffsets));
+  fanOutEdges.resize(fanOutOffsets.back());
+  fanInEdges.resize(fanInOffsets.back());
+  std::vector<uint64_t> next(std::begin(fanInOffsets),
+                             std::end(fanInOffsets) - 1);
+  for (NodeID node = 0; node < nodes.size(); ++node) {
+    std::copy(std::begin(fanOut[node]), std::end(fanOut[node]),
+              std::begin(fanOutEdges) + fanOutOffsets[node]);
+    for (auto succ : fanOut[node]) {
+      fanInEdges[next[succ]++] = node;
+    }
+    std::vector<NodeID>().swap(fanOut[node]);
+  }
+}
+
+/// Determine the minimum number of registers on a path from any input port to
+/// each node, once, so that depth queries are lookups.
+void RegisterGraph::determinePipelineDepths() {
+  auto &depths = pipelineDepths;
+  depths.assign(nodes.size(), -1);
+  std::deque<NodeID> worklist;
+  auto isReg = [this](NodeID node) {
+    auto vertex = nodes[node].startVertex != graph.nullVertex() ?
+                    nodes[node].startVertex : nodes[node].finishVertex;
+    return graph.getVertex(vertex).isReg();
+  };
+  for (NodeID node = 0; node < nodes.size(); ++node) {
+    if (nodes[node].startVertex != graph.nullVertex() && !isReg(node)) {
+      depths[node] = 0;
+      worklist.push_back(node);
+    }
+  }
+  // Breadth-first search with edge weights of one into a register and zero
+  // otherwise.
+  while (!worklist.empty()) {
+    auto node = worklist.front();
+    worklist.pop_front();
+    for (auto i = fanOutOffsets[node]; i < fanOutOffsets[node + 1]; ++i) {
+      auto succ = fanOutEdges[i];
+      auto weight = isReg(succ) ? 1 : 0;
+      if (depths[succ] == -1 || depths[node] + weight < depths[succ]) {
+        depths[succ] = depths[node] + weight;
+        if (weight) {
+          worklist.push_back(succ);
+        } else {
+          worklist.push_front(succ);
+        }
+      }
+    }
+  }
+}
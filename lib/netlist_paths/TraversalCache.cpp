@@ -0,0 +1,86 @@
+#include <algorithm>
+#include "netlist_paths/TraversalCache.hpp"
+
+using namespace netlist_paths;
+
+TraversalTree::TraversalTree(VertexID root,
+                             bool reverse,
+                             bool depthFirst,
+                             const TraversalScratch &scratch) :
+    root(root), reverse(reverse), depthFirst(depthFirst) {
+  parents.reserve(scratch.reached.size());
+  for (auto vertex : scratch.reached) {
+    parents.emplace_back(vertex, scratch.parents[vertex]);
+  }
+  std::sort(std::begin(parents), std::end(parents));
+}
+
+bool TraversalTree::isReached(VertexID vertex) const {
+  auto it = std::lower_bound(std::begin(parents), std::end(parents),
+                             std::make_pair(vertex, VertexID(0)));
+  return it != std::end(parents) && it->first == vertex;
+}
+
+/// Return the parent of a reached vertex.
+VertexID TraversalTree::getParent(VertexID vertex) const {
+  auto it = std::lower_bound(std::begin(parents), std::end(parents),
+                             std::make_pair(vertex, VertexID(0)));
+  return it->second;
+}
+
+std::shared_ptr<const TraversalTree>
+TraversalCache::lookup(VertexID root, bool reverse) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(std::make_pair(root, reverse));
+  if (it == index.end()) {
+    misses++;
+    return nullptr;
+  }
+  hits++;
+  entries.splice(entries.begin(), entries, it->second);
+  return it->second->second;
+}
+
+void TraversalCache::insert(std::shared_ptr<const TraversalTree> tree,
+                            std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto key = std::make_pair(tree->getRoot(), tree->isReverse());
+  auto it = index.find(key);
+  if (it != index.end()) {
+    numBytes -= it->second->second->memoryUsage();
+    entries.erase(it->second);
+    index.erase(it);
+  }
+  if (tree->memoryUsage() > capacity) {
+    evict(capacity);
+    return;
+  }
+  numBytes += tree->memoryUsage();
+  entries.emplace_front(key, std::move(tree));
+  index[key] = entries.begin();
+  evict(capacity);
+}
+
+/// Remove the least-recently-used entries until the cache fits a capacity.
+void TraversalCache::evict(std::size_t capacity) {
+  while (numBytes > capacity) {
+    auto &entry = entries.back();
+    numBytes -= entry.second->memoryUsage();
+    index.erase(entry.first);
+    entries.pop_back();
+  }
+}
+
+void TraversalCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  index.clear();
+  numBytes = 0;
+  hits = 0;
+  misses = 0;
+}
+
+TraversalCacheStats TraversalCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return {hits, misses, entries.size(), numBytes};
+}
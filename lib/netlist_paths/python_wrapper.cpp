@@ -3,6 +3,7 @@
 #include "netlist_paths/Exception.hpp"
 #include "netlist_paths/Netlist.hpp"
 #include "netlist_paths/Options.hpp"
+#include "netlist_paths/QueryContext.hpp"
 #include "netlist_paths/RunVerilator.hpp"
 #include "netlist_paths/Waypoints.hpp"
 
@@ -10,12 +11,467 @@ void translateException(const netlist_paths::Exception& e) {
   PyErr_SetString(PyExc_RuntimeError, e.what());
 };
 
+/// Release the GIL for the lifetime of the object, so that other Python
+/// threads can run while a query or ingest executes. No Python objects may
+/// be used while it is released.
+class ScopedGILRelease {
+  PyThreadState *state;
+public:
+  ScopedGILRelease() : state(PyEval_SaveThread()) {}
+  ~ScopedGILRelease() { PyEval_RestoreThread(state); }
+};
+
+/// Wrap a member function so that it is called with the GIL released. The
+/// arguments are converted from Python before the call and the result is
+/// converted to Python after it, with the GIL held.
+template<typename Signature, Signature Fn>
+struct ReleaseGIL;
+
+template<typename C, typename R, typename... Args, R (C::*Fn)(Args...) const>
+struct ReleaseGIL<R (C::*)(Args...) const, Fn> {
+  static R call(const C &object, Args... args) {
+    ScopedGILRelease release;
+    return (object.*Fn)(args...);
+  }
+};
+
+template<typename C, typename R, typename... Args, R (C::*Fn)(Args...)>
+struct ReleaseGIL<R (C::*)(Args...), Fn> {
+  static R call(C &object, Args... args) {
+    ScopedGILRelease release;
+    return (object.*Fn)(args...);
+  }
+};
+
+#define RELEASE_GIL(fn) &ReleaseGIL<decltype(fn), fn>::call
+
+/// Read a netlist with the GIL released.
+netlist_paths::Netlist *createNetlist(const std::string &filename) {
+  ScopedGILRelease release;
+  return new netlist_paths::Netlist(filename);
+}
+
+/// Answer a list of path existence queries, given as a Python list of
+/// Waypoints objects, with a list of Booleans.
+boost::python::list pathsExist(netlist_paths::Netlist &netlist,
+                               boost::python::list waypointsList) {
+  std::vector<netlist_paths::Waypoints> waypoints;
+  for (long i = 0; i < boost::python::len(waypointsList); ++i) {
+    waypoints.push_back(
+        boost::python::extract<netlist_paths::Waypoints>(waypointsList[i]));
+  }
+  std::vector<bool> results;
+  {
+    ScopedGILRelease release;
+    results = netlist.pathsExist(waypoints);
+  }
+  boost::python::list result;
+  for (bool exists : results) {
+    result.append(exists);
+  }
+  return result;
+}
+
+/// Convert a Python list of names to a vector of strings.
+std::vector<std::string> extractNames(boost::python::list names) {
+  std::vector<std::string> result;
+  for (long i = 0; i < boost::python::len(names); ++i) {
+    result.push_back(boost::python::extract<std::string>(names[i]));
+  }
+  return result;
+}
+
+/// Enter a query context on the calling thread for the body of a with
+/// statement.
+netlist_paths::QueryContext &enterQueryContext(netlist_paths::QueryContext &context) {
+  context.enter();
+  return context;
+}
+
+void exitQueryContext(netlist_paths::QueryContext &context,
+                      boost::python::object, boost::python::object,
+                      boost::python::object) {
+  context.exit();
+}
+
+/// A Python iterator over the paths produced by an enumerator. Each path is
+/// found with the GIL released.
+class PathIterator {
+  const netlist_paths::Netlist *netlist;
+  std::shared_ptr<netlist_paths::PathEnumerator> enumerator;
+
+public:
+  PathIterator(const netlist_paths::Netlist &netlist,
+               std::unique_ptr<netlist_paths::PathEnumerator> enumerator) :
+      netlist(&netlist), enumerator(std::move(enumerator)) {}
+
+  std::vector<netlist_paths::Vertex*> next() {
+    netlist_paths::VertexIDVec path;
+    bool found;
+    {
+      ScopedGILRelease release;
+      found = enumerator->next(path);
+    }
+    if (!found) {
+      PyErr_SetNone(PyExc_StopIteration);
+      boost::python::throw_error_already_set();
+    }
+    std::vector<netlist_paths::Vertex*> result;
+    for (auto vertex : path) {
+      result.push_back(netlist->getVertex(vertex));
+    }
+    return result;
+  }
+};
+
+PathIterator iterAllPaths(netlist_paths::Netlist &netlist,
+                          netlist_paths::Waypoints waypoints) {
+  ScopedGILRelease release;
+  return PathIterator(netlist, netlist.getAllPathsEnumerator(waypoints));
+}
+
+PathIterator iterAllFanOut(netlist_paths::Netlist &netlist,
+                           const std::string &startName,
+                           boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  ScopedGILRelease release;
+  return PathIterator(netlist, netlist.getAllFanOutEnumerator(startName, avoid));
+}
+
+PathIterator iterAllFanIn(netlist_paths::Netlist &netlist,
+                          const std::string &finishName,
+                          boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  ScopedGILRelease release;
+  return PathIterator(netlist, netlist.getAllFanInEnumerator(finishName, avoid));
+}
+
+/// Return the fan out paths of a start point, not passing through any vertex
+/// matching a list of avoid points.
+std::vector<std::vector<netlist_paths::Vertex*> >
+getAllFanOut(netlist_paths::Netlist &netlist,
+             const std::string &startName,
+             boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  ScopedGILRelease release;
+  return netlist.getAllFanOut(startName, avoid);
+}
+
+/// Return the fan in paths of a finish point, not passing through any vertex
+/// matching a list of avoid points.
+std::vector<std::vector<netlist_paths::Vertex*> >
+getAllFanIn(netlist_paths::Netlist &netlist,
+            const std::string &finishName,
+            boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  ScopedGILRelease release;
+  return netlist.getAllFanIn(finishName, avoid);
+}
+
+BOOST_PYTHON_FUNCTION_OVERLOADS(iter_all_fanout_overloads, iterAllFanOut, 2, 3);
+BOOST_PYTHON_FUNCTION_OVERLOADS(iter_all_fanin_overloads, iterAllFanIn, 2, 3);
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_all_fanout_overloads, getAllFanOut, 2, 3);
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_all_fanin_overloads, getAllFanIn, 2, 3);
+
+/// Return a list of the fan out paths of each of a list of start points, not
+/// passing through any vertex matching a list of avoid points.
+boost::python::list getAllFanOutMulti(netlist_paths::Netlist &netlist,
+                                      boost::python::list startNames,
+                                      boost::python::list avoidPoints=boost::python::list()) {
+  auto names = extractNames(startNames);
+  auto avoid = extractNames(avoidPoints);
+  std::vector<std::vector<std::vector<netlist_paths::Vertex*> > > fanOut;
+  {
+    ScopedGILRelease release;
+    fanOut = netlist.getAllFanOutMulti(names, avoid);
+  }
+  boost::python::list result;
+  for (auto &paths : fanOut) {
+    result.append(paths);
+  }
+  return result;
+}
+
+/// Return a list of the fan in paths of each of a list of finish points, not
+/// passing through any vertex matching a list of avoid points.
+boost::python::list getAllFanInMulti(netlist_paths::Netlist &netlist,
+                                     boost::python::list finishNames,
+                                     boost::python::list avoidPoints=boost::python::list()) {
+  auto names = extractNames(finishNames);
+  auto avoid = extractNames(avoidPoints);
+  std::vector<std::vector<std::vector<netlist_paths::Vertex*> > > fanIn;
+  {
+    ScopedGILRelease release;
+    fanIn = netlist.getAllFanInMulti(names, avoid);
+  }
+  boost::python::list result;
+  for (auto &paths : fanIn) {
+    result.append(paths);
+  }
+  return result;
+}
+
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_all_fanout_multi_overloads, getAllFanOutMulti, 2, 3);
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_all_fanin_multi_overloads, getAllFanInMulti, 2, 3);
+
+/// Convert a vector of vertices and their counts to a list of tuples.
+boost::python::list
+createCountList(const std::vector<std::pair<netlist_paths::Vertex*, std::size_t> > &counts) {
+  boost::python::list result;
+  for (auto &count : counts) {
+    result.append(boost::python::make_tuple(
+        boost::python::ptr(count.first), count.second));
+  }
+  return result;
+}
+
+/// Return a list of (vertex, degree) tuples for every start point.
+boost::python::list getAllFanOutDegrees(netlist_paths::Netlist &netlist) {
+  std::vector<std::pair<netlist_paths::Vertex*, std::size_t> > counts;
+  {
+    ScopedGILRelease release;
+    counts = netlist.getAllFanOutDegrees();
+  }
+  return createCountList(counts);
+}
+
+/// Return a list of (vertex, degree) tuples for every finish point.
+boost::python::list getAllFanInDegrees(netlist_paths::Netlist &netlist) {
+  std::vector<std::pair<netlist_paths::Vertex*, std::size_t> > counts;
+  {
+    ScopedGILRelease release;
+    counts = netlist.getAllFanInDegrees();
+  }
+  return createCountList(counts);
+}
+
+/// Return a list of (vertex, depth) tuples for every finish point with a
+/// logic depth.
+boost::python::list getAllLogicDepths(netlist_paths::Netlist &netlist) {
+  std::vector<std::pair<netlist_paths::Vertex*, std::size_t> > counts;
+  {
+    ScopedGILRelease release;
+    counts = netlist.getAllLogicDepths();
+  }
+  return createCountList(counts);
+}
+
+/// Return a list of the number of finish points with each logic depth.
+boost::python::list getLogicDepthHistogram(netlist_paths::Netlist &netlist) {
+  std::vector<std::size_t> histogram;
+  {
+    ScopedGILRelease release;
+    histogram = netlist.getLogicDepthHistogram();
+  }
+  boost::python::list result;
+  for (auto count : histogram) {
+    result.append(count);
+  }
+  return result;
+}
+
+/// Return a list of (module, finish points, max depth, mean depth) tuples.
+boost::python::list getLogicDepthModuleStats(netlist_paths::Netlist &netlist) {
+  std::vector<netlist_paths::LogicDepth::ModuleStats> stats;
+  {
+    ScopedGILRelease release;
+    stats = netlist.getLogicDepthModuleStats();
+  }
+  boost::python::list result;
+  for (auto &module : stats) {
+    result.append(boost::python::make_tuple(
+        module.name, module.numFinishPoints, module.maxDepth,
+        static_cast<double>(module.totalDepth) / module.numFinishPoints));
+  }
+  return result;
+}
+
+/// Return a (hits, misses, entries, bytes) tuple for the traversal cache.
+boost::python::tuple getTraversalCacheStats(netlist_paths::Netlist &netlist) {
+  auto stats = netlist.getTraversalCacheStats();
+  return boost::python::make_tuple(stats.hits, stats.misses,
+                                   stats.numEntries, stats.numBytes);
+}
+
+/// Return a list of the names of the instances directly within a scope.
+boost::python::list getChildScopes(netlist_paths::Netlist &netlist,
+                                   const std::string &scope) {
+  boost::python::list result;
+  for (auto &name : netlist.getChildScopes(scope)) {
+    result.append(name);
+  }
+  return result;
+}
+
+/// Return a (start points, finish points, connected, paths) tuple for the
+/// start and finish points matching two patterns. connected[i][j] indicates
+/// whether start point i has a path to finish point j, not passing through
+/// any vertex matching a list of avoid points, and, if paths are requested,
+/// paths[i][j] is an example of it, otherwise paths is empty.
+boost::python::tuple getPathMatrix(netlist_paths::Netlist &netlist,
+                                   const std::string &startPattern,
+                                   const std::string &finishPattern,
+                                   bool withPaths=false,
+                                   boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  netlist_paths::Netlist::PathMatrix matrix;
+  {
+    ScopedGILRelease release;
+    matrix = netlist.getPathMatrix(startPattern, finishPattern, withPaths, avoid);
+  }
+  boost::python::list startPoints;
+  for (auto vertex : matrix.startPoints) {
+    startPoints.append(boost::python::ptr(vertex));
+  }
+  boost::python::list finishPoints;
+  for (auto vertex : matrix.finishPoints) {
+    finishPoints.append(boost::python::ptr(vertex));
+  }
+  boost::python::list connected;
+  for (auto &row : matrix.connected) {
+    boost::python::list connectedRow;
+    for (bool exists : row) {
+      connectedRow.append(exists);
+    }
+    connected.append(connectedRow);
+  }
+  boost::python::list paths;
+  for (auto &row : matrix.paths) {
+    boost::python::list pathsRow;
+    for (auto &path : row) {
+      pathsRow.append(path);
+    }
+    paths.append(pathsRow);
+  }
+  return boost::python::make_tuple(startPoints, finishPoints, connected, paths);
+}
+
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_path_matrix_overloads, getPathMatrix, 3, 5);
+
+/// Return a memoryview of an array, cast to a buffer protocol format, such
+/// as 'Q' for uint64_t, so that it can be indexed directly or wrapped by
+/// numpy.frombuffer without converting each element. The array is copied once
+/// into a bytes object owned by the view.
+template<typename T>
+boost::python::object createArrayView(const std::vector<T> &values,
+                                      const char *format) {
+  boost::python::object bytes(boost::python::handle<>(
+      PyBytes_FromStringAndSize(reinterpret_cast<const char*>(values.data()),
+                                values.size() * sizeof(T))));
+  boost::python::object view(boost::python::handle<>(
+      PyMemoryView_FromObject(bytes.ptr())));
+  return view.attr("cast")(format);
+}
+
+/// Return an (offsets, vertices) tuple of uint64 arrays for a list of paths,
+/// see Netlist::PathArrays.
+boost::python::tuple
+createPathArrays(const std::vector<netlist_paths::VertexIDVec> &paths) {
+  netlist_paths::Netlist::PathArrays arrays;
+  {
+    ScopedGILRelease release;
+    arrays = netlist_paths::Netlist::createPathArrays(paths);
+  }
+  return boost::python::make_tuple(createArrayView(arrays.offsets, "Q"),
+                                   createArrayView(arrays.vertices, "Q"));
+}
+
+/// Return a uint64 array of the vertex IDs of any path between two points.
+boost::python::object getAnyPathArray(netlist_paths::Netlist &netlist,
+                                      netlist_paths::Waypoints waypoints) {
+  netlist_paths::VertexIDVec path;
+  {
+    ScopedGILRelease release;
+    path = netlist.getAnyPathIds(waypoints);
+  }
+  return createArrayView(std::vector<uint64_t>(path.begin(), path.end()), "Q");
+}
+
+boost::python::tuple getAllPathsArrays(netlist_paths::Netlist &netlist,
+                                       netlist_paths::Waypoints waypoints) {
+  std::vector<netlist_paths::VertexIDVec> paths;
+  {
+    ScopedGILRelease release;
+    paths = netlist.getAllPathsIds(waypoints);
+  }
+  return createPathArrays(paths);
+}
+
+boost::python::tuple getAllFanOutArrays(netlist_paths::Netlist &netlist,
+                                        const std::string &startName,
+                                        boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  std::vector<netlist_paths::VertexIDVec> paths;
+  {
+    ScopedGILRelease release;
+    paths = netlist.getAllFanOutIds(startName, avoid);
+  }
+  return createPathArrays(paths);
+}
+
+boost::python::tuple getAllFanInArrays(netlist_paths::Netlist &netlist,
+                                       const std::string &finishName,
+                                       boost::python::list avoidPoints=boost::python::list()) {
+  auto avoid = extractNames(avoidPoints);
+  std::vector<netlist_paths::VertexIDVec> paths;
+  {
+    ScopedGILRelease release;
+    paths = netlist.getAllFanInIds(finishName, avoid);
+  }
+  return createPathArrays(paths);
+}
+
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_all_fanout_arrays_overloads, getAllFanOutArrays, 2, 3);
+BOOST_PYTHON_FUNCTION_OVERLOADS(get_all_fanin_arrays_overloads, getAllFanInArrays, 2, 3);
+
+/// Return a dictionary of the columns of the vertex table, see
+/// Netlist::VertexTable, with the names of the AST type and direction codes.
+boost::python::dict getVertexTable(netlist_paths::Netlist &netlist) {
+  using namespace netlist_paths;
+  Netlist::VertexTable table;
+  {
+    ScopedGILRelease release;
+    table = netlist.getVertexTable();
+  }
+  boost::python::dict result;
+  result["ast_type"] = createArrayView(table.astTypes, "B");
+  result["direction"] = createArrayView(table.directions, "B");
+  result["width"] = createArrayView(table.widths, "I");
+  result["name_offsets"] = createArrayView(table.nameOffsets, "Q");
+  result["names"] = boost::python::object(boost::python::handle<>(
+      PyBytes_FromStringAndSize(table.names.data(), table.names.size())));
+  boost::python::list astTypeNames;
+  for (int i = 0; i <= static_cast<int>(VertexAstType::INVALID); ++i) {
+    astTypeNames.append(getVertexAstTypeStr(static_cast<VertexAstType>(i)));
+  }
+  result["ast_type_names"] = astTypeNames;
+  boost::python::list directionNames;
+  for (int i = 0; i <= static_cast<int>(VertexDirection::INOUT); ++i) {
+    directionNames.append(getVertexDirectionStr(static_cast<VertexDirection>(i)));
+  }
+  result["direction_names"] = directionNames;
+  return result;
+}
+
+/// Return a new netlist of the fan in and/or fan out cones of a list of
+/// points, owned by Python.
+netlist_paths::Netlist *extractCone(netlist_paths::Netlist &netlist,
+                                    boost::python::list names,
+                                    bool fanIn, bool fanOut) {
+  auto coneNames = extractNames(names);
+  ScopedGILRelease release;
+  return netlist.extractCone(coneNames, fanIn, fanOut).release();
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(get_vertex_dtype_str_overloads,
                                        getVertexDTypeStr, 1, 2);
 
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(get_vertex_dtype_width_overloads,
                                        getVertexDTypeWidth, 1, 2);
 
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(get_num_named_vertices_overloads,
+                                       getNumNamedVertices, 0, 1);
+
 BOOST_PYTHON_MODULE(py_netlist_paths)
 {
   using namespace boost::python;
@@ -25,13 +481,15 @@ BOOST_PYTHON_MODULE(py_netlist_paths)
   register_exception_translator<Exception>(&translateException);
 
   class_<Vertex, Vertex*, boost::noncopyable>("Vertex")
-     .def("get_name",        &Vertex::getName)
+     .def("get_name",        &Vertex::getName,
+                             return_value_policy<copy_const_reference>())
      .def("get_ast_type",    &Vertex::getAstTypeStr)
      .def("get_direction",   &Vertex::getDirStr)
      .def("get_dtype_str",   &Vertex::getDTypeStr)
      .def("get_dtype_width", &Vertex::getDTypeWidth)
      .def("get_location",    &Vertex::getLocStr)
-     .def("can_ignore",      &Vertex::canIgnore);
+     .def("can_ignore",      &Vertex::canIgnore)
+     .def("is_logic",        &Vertex::isLogic);
 
   class_<std::vector<Vertex*> >("Path")
       .def(vector_indexing_suite<std::vector<Vertex*> >());
@@ -39,42 +497,118 @@ BOOST_PYTHON_MODULE(py_netlist_paths)
   class_<std::vector<std::vector<Vertex*> > >("PathList")
       .def(vector_indexing_suite<std::vector<std::vector<Vertex*> > >());
 
+  class_<PathIterator>("PathIterator", no_init)
+    .def("__iter__", objects::identity_function())
+    .def("__next__", &PathIterator::next);
+
   class_<Options, boost::noncopyable>("Options", no_init)
-    .def("get_instance",       &Options::getInstancePtr,
-                               return_value_policy<reference_existing_object>())
+    .def("get_instance",             &Options::getInstancePtr,
+                                     return_value_policy<reference_existing_object>())
     .staticmethod("get_instance")
-    .def("set_verbose",        &Options::setVerbose)
-    .def("set_debug",          &Options::setDebug)
-    .def("set_match_wildcard", &Options::setMatchWildcard)
-    .def("set_match_regex",    &Options::setMatchRegex);
+    .def("set_verbose",              &Options::setVerbose)
+    .def("set_debug",                &Options::setDebug)
+    .def("set_match_wildcard",       &Options::setMatchWildcard)
+    .def("set_match_regex",          &Options::setMatchRegex)
+    .def("set_num_threads",          &Options::setNumThreads)
+    .def("set_bfs_threshold",        &Options::setBFSThreshold)
+    .def("set_traversal_cache_size", &Options::setTraversalCacheSize);
+
+  class_<QueryContext, boost::noncopyable>("QueryContext")
+    .def("__enter__",          &enterQueryContext, return_self<>())
+    .def("__exit__",           &exitQueryContext)
+    .def("get_match_wildcard", &QueryContext::getMatchWildcard)
+    .def("set_verbose",        &QueryContext::setVerbose)
+    .def("set_debug",          &QueryContext::setDebug)
+    .def("set_match_wildcard", &QueryContext::setMatchWildcard)
+    .def("set_match_regex",    &QueryContext::setMatchRegex)
+    .def("set_num_threads",    &QueryContext::setNumThreads)
+    .def("set_bfs_threshold",  &QueryContext::setBFSThreshold)
+    .def("set_traversal_cache_size", &QueryContext::setTraversalCacheSize);
 
   int (RunVerilator::*run)(const std::string&, const std::string&) const = &RunVerilator::run;
 
   class_<RunVerilator, boost::noncopyable>("RunVerilator",
                                            init<const std::string&>())
-    .def("run", run);
+    .def("run", &ReleaseGIL<decltype(run), &RunVerilator::run>::call);
 
   class_<Waypoints>("Waypoints")
     .def(init<const std::string, const std::string>())
     .def("add_start_point",   &Waypoints::addStartPoint)
     .def("add_finish_point",  &Waypoints::addFinishPoint)
-    .def("add_through_point", &Waypoints::addThroughPoint);
-
-  class_<Netlist, boost::noncopyable>("Netlist",
-                                      init<const std::string&>())
-    .def("get_named_vertices",     &Netlist::getNamedVerticesPtr)
-    .def("reg_exists",             &Netlist::regExists)
-    .def("startpoint_exists",      &Netlist::startpointExists)
-    .def("endpoint_exists",        &Netlist::endpointExists)
-    .def("path_exists",            &Netlist::pathExists)
-    .def("get_any_path",           &Netlist::getAnyPath)
-    .def("get_all_paths",          &Netlist::getAllPaths)
-    .def("get_all_fanout_paths",   &Netlist::getAllFanOut)
-    .def("get_all_fanin_paths",    &Netlist::getAllFanIn)
-    .def("get_dtype_width",        &Netlist::getDTypeWidth)
-    .def("get_vertex_dtype_str",   &Netlist::getVertexDTypeStr,
-                                   get_vertex_dtype_str_overloads())
-    .def("get_vertex_dtype_width", &Netlist::getVertexDTypeWidth,
-                                   get_vertex_dtype_width_overloads())
-    .def("dump_dot_file",          &Netlist::dumpDotFile);
+    .def("add_through_point", &Waypoints::addThroughPoint)
+    .def("add_avoid_point",   &Waypoints::addAvoidPoint);
+
+  class_<Netlist, boost::noncopyable>("Netlist", no_init)
+    .def("__init__",                   make_constructor(&createNetlist))
+    .def("get_named_vertices",         RELEASE_GIL(&Netlist::getNamedVerticesPtr))
+    .def("get_named_vertices_page",    RELEASE_GIL(&Netlist::getNamedVerticesPage))
+    .def("get_num_named_vertices",     &Netlist::getNumNamedVertices,
+                                       get_num_named_vertices_overloads())
+    .def("get_vertices_in_scope",      RELEASE_GIL(&Netlist::getVerticesInScope))
+    .def("get_child_scopes",           &getChildScopes)
+    .def("get_registers_in_scope",     RELEASE_GIL(&Netlist::getRegistersInScope))
+    .def("get_paths_leaving_scope",    RELEASE_GIL(&Netlist::getPathsLeavingScope))
+    .def("reg_exists",                 RELEASE_GIL(&Netlist::regExists))
+    .def("startpoint_exists",          RELEASE_GIL(&Netlist::startpointExists))
+    .def("endpoint_exists",            RELEASE_GIL(&Netlist::endpointExists))
+    .def("path_exists",                RELEASE_GIL(&Netlist::pathExists))
+    .def("paths_exist",                &pathsExist)
+    .def("get_path_matrix",            &getPathMatrix,
+                                       get_path_matrix_overloads())
+    .def("get_any_path",               RELEASE_GIL(&Netlist::getAnyPath))
+    .def("get_all_paths",              RELEASE_GIL(&Netlist::getAllPaths))
+    .def("get_all_fanout_paths",       &getAllFanOut,
+                                       get_all_fanout_overloads())
+    .def("get_all_fanin_paths",        &getAllFanIn,
+                                       get_all_fanin_overloads())
+    .def("get_all_fanout_paths_multi", &getAllFanOutMulti,
+                                       get_all_fanout_multi_overloads())
+    .def("get_all_fanin_paths_multi",  &getAllFanInMulti,
+                                       get_all_fanin_multi_overloads())
+    .def("iter_all_paths",             &iterAllPaths,
+                                       with_custodian_and_ward_postcall<0, 1>())
+    .def("iter_all_fanout_paths",      &iterAllFanOut,
+                                       iter_all_fanout_overloads()[
+                                         with_custodian_and_ward_postcall<0, 1>()])
+    .def("iter_all_fanin_paths",       &iterAllFanIn,
+                                       iter_all_fanin_overloads()[
+                                         with_custodian_and_ward_postcall<0, 1>()])
+    .def("get_any_path_array",         &getAnyPathArray)
+    .def("get_all_paths_arrays",       &getAllPathsArrays)
+    .def("get_all_fanout_arrays",      &getAllFanOutArrays,
+                                       get_all_fanout_arrays_overloads())
+    .def("get_all_fanin_arrays",       &getAllFanInArrays,
+                                       get_all_fanin_arrays_overloads())
+    .def("get_vertex_table",           &getVertexTable)
+    .def("get_vertex",                 &Netlist::getVertex,
+                                       return_value_policy<reference_existing_object>())
+    .def("get_fanout_degree",          RELEASE_GIL(&Netlist::getFanOutDegree))
+    .def("get_fanin_degree",           RELEASE_GIL(&Netlist::getFanInDegree))
+    .def("get_all_fanout_degrees",     &getAllFanOutDegrees)
+    .def("get_all_fanin_degrees",      &getAllFanInDegrees)
+    .def("get_logic_depth",            RELEASE_GIL(&Netlist::getLogicDepth))
+    .def("get_all_logic_depths",       &getAllLogicDepths)
+    .def("get_deepest_paths",          RELEASE_GIL(&Netlist::getDeepestPaths))
+    .def("get_logic_depth_histogram",  &getLogicDepthHistogram)
+    .def("get_module_depth_stats",     &getLogicDepthModuleStats)
+    .def("get_comb_loops",             RELEASE_GIL(&Netlist::getCombLoops))
+    .def("get_register_fanout",        RELEASE_GIL(&Netlist::getRegisterFanOut))
+    .def("get_register_fanin",         RELEASE_GIL(&Netlist::getRegisterFanIn))
+    .def("get_pipeline_depth",         RELEASE_GIL(&Netlist::getPipelineDepth))
+    .def("get_dtype_width",            &Netlist::getDTypeWidth)
+    .def("get_vertex_dtype_str",       &Netlist::getVertexDTypeStr,
+                                       get_vertex_dtype_str_overloads())
+    .def("get_vertex_dtype_width",     &Netlist::getVertexDTypeWidth,
+                                       get_vertex_dtype_width_overloads())
+    .def("num_vertices",               &Netlist::numVertices)
+    .def("num_edges",                  &Netlist::numEdges)
+    .def("extract_cone",               &extractCone,
+                                       return_value_policy<manage_new_object>())
+    .def("get_traversal_cache_stats",  &getTraversalCacheStats)
+    .def("clear_traversal_cache",      &Netlist::clearTraversalCache)
+    .def("dump_dot_file",              RELEASE_GIL(&Netlist::dumpDotFile))
+    .def("build_reachability_index",   RELEASE_GIL(&Netlist::buildReachabilityIndex))
+    .def("load_reachability_index",    RELEASE_GIL(&Netlist::loadReachabilityIndex))
+    .def("save_reachability_index",    RELEASE_GIL(&Netlist::saveReachabilityIndex))
+    .def("has_reachability_index",     &Netlist::hasReachabilityIndex);
 }
@@ -3,9 +3,12 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <thread>
 #include <boost/test/unit_test.hpp>
 #include "tests/definitions.hpp"
 #include "TestContext.hpp"
+#include "netlist_paths/NameIndex.hpp"
+#include "netlist_paths/NameMatcher.hpp"
 
 /// Test matching of names by wildcards and regexes.
 BOOST_FIXTURE_TEST_CASE(name_matching, TestContext) {
@@ -26,3 +29,153 @@ BOOST_FIXTURE_TEST_CASE(name_matching, TestContext) {
   BOOST_CHECK_THROW(np->regExists("*data_q"), netlist_paths::Exception);
   BOOST_CHECK_THROW(np->regExists("?data_q"), netlist_paths::Exception);
 }
+
+/// Test compiled patterns give the same results as the regexes they replace.
+BOOST_AUTO_TEST_CASE(name_matcher) {
+  using netlist_paths::NameMatcher;
+  // Wildcard, with separators matching any character.
+  NameMatcher wildcard("pipeline/*/data_q*", true, true);
+  BOOST_TEST(wildcard.isCompiled());
+  BOOST_TEST(wildcard.match("pipeline.g_stage.data_q"));
+  BOOST_TEST(wildcard.match("x_pipeline_a_data_q_y"));
+  BOOST_TEST(!wildcard.match("pipeline.data_q"));
+  NameMatcher anchored("^d?t?_q$", true, true);
+  BOOST_TEST(anchored.isCompiled());
+  BOOST_TEST(anchored.match("data_q"));
+  BOOST_TEST(!anchored.match("data_q2"));
+  BOOST_TEST(!anchored.match("xdata_q"));
+  // Regex.
+  NameMatcher regex("^pipeline\\..*data_q$", false, false);
+  BOOST_TEST(!regex.isCompiled());
+  BOOST_TEST(regex.match("pipeline.g.data_q"));
+  BOOST_TEST(!regex.match("pipelinexg.data_q"));
+  NameMatcher regexAny("pipeline.*data.q", false, false);
+  BOOST_TEST(regexAny.isCompiled());
+  BOOST_TEST(regexAny.match("pipeline.g.data_q"));
+  BOOST_TEST(!regexAny.match("pipeline.g.data__q"));
+  BOOST_CHECK_THROW(NameMatcher("*data_q", false, false), netlist_paths::Exception);
+}
+
+/// Test the literals required by patterns, used to screen candidate names.
+BOOST_AUTO_TEST_CASE(name_matcher_literals) {
+  using netlist_paths::NameMatcher;
+  BOOST_TEST(NameMatcher("*u_fifo*", true, false).getRequiredLiteral() == "u_fifo");
+  BOOST_TEST(NameMatcher("*u_fifo*", true, true).getRequiredLiteral() == "fifo");
+  BOOST_TEST(NameMatcher("top\\.core[0-3]\\.alu", false, false).getRequiredLiteral() == "top.core");
+  BOOST_TEST(NameMatcher("(ab)?cdef+g", false, false).getRequiredLiteral() == "cdef");
+  BOOST_TEST(NameMatcher("abcd*e", false, false).getRequiredLiteral() == "abc");
+  BOOST_TEST(NameMatcher("fifo|alu", false, false).getRequiredLiteral() == "");
+  BOOST_TEST(NameMatcher(".*", false, false).getRequiredLiteral() == "");
+}
+
+/// Test the top and basename of vertices from the instance hierarchy.
+BOOST_AUTO_TEST_CASE(name_index_hierarchy) {
+  netlist_paths::NameIndex index;
+  index.insert("in", 0);
+  index.insert("top.in", 1);
+  index.insert("top.u_sub.x", 3);
+  index.insert("", 4);
+  // Only '.' separates the components of names, and empty components count.
+  index.insert("top.a/b", 6);
+  index.insert("top..c", 7);
+  BOOST_TEST(index.isTop(0));
+  BOOST_TEST(index.isTop(1));
+  BOOST_TEST(!index.isTop(3));
+  BOOST_TEST(index.getBasename(1) == "in");
+  BOOST_TEST(index.getBasename(3) == "x");
+  BOOST_TEST(index.isTop(6));
+  BOOST_TEST(index.getBasename(6) == "a/b");
+  BOOST_TEST(!index.isTop(7));
+  BOOST_TEST(index.getBasename(7) == "c");
+  // Scopes in queries can also be separated by '/'.
+  BOOST_TEST(index.getVerticesInScope("top/u_sub") ==
+             netlist_paths::VertexIDVec{3});
+  BOOST_TEST(index.getVerticesInScope("top.u_sub") ==
+             netlist_paths::VertexIDVec{3});
+  BOOST_TEST(index.getChildScopes("top") ==
+             std::vector<std::string>{"", "u_sub"});
+  // Vertices without names: not added, beyond the index, or with an empty
+  // name at the root of the hierarchy.
+  for (netlist_paths::VertexID vertex : {2, 4, 5}) {
+    BOOST_TEST(!index.isTop(vertex));
+    BOOST_TEST(index.getBasename(vertex).empty());
+  }
+}
+
+/// Test the named vertices are listed in name order and by pages of a prefix.
+BOOST_FIXTURE_TEST_CASE(named_vertex_pages, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("pipeline_module.sv", "pipeline"));
+  auto vertices = np->getNamedVerticesPtr();
+  BOOST_TEST(vertices.size() == np->getNumNamedVertices());
+  BOOST_TEST(std::is_sorted(vertices.begin(), vertices.end(),
+                            [](const netlist_paths::Vertex *a,
+                               const netlist_paths::Vertex *b) {
+                              return a->getName() < b->getName(); }));
+  auto filtered = np->getNamedVerticesPtr("data_q");
+  BOOST_TEST(filtered.size() > 1);
+  BOOST_TEST(std::is_sorted(filtered.begin(), filtered.end(),
+                            [](const netlist_paths::Vertex *a,
+                               const netlist_paths::Vertex *b) {
+                              return a->getName() < b->getName(); }));
+  // Pages of the names in a scope.
+  auto prefix = std::string("pipeline_module.g_pipestage[1]");
+  auto count = np->getNumNamedVertices(prefix);
+  BOOST_TEST(count > 2);
+  auto first = np->getNamedVerticesPage(prefix, 0, 2);
+  auto rest = np->getNamedVerticesPage(prefix, 2, count);
+  BOOST_TEST(first.size() == 2);
+  BOOST_TEST(rest.size() == count - 2);
+  first.insert(first.end(), rest.begin(), rest.end());
+  for (auto vertex : first) {
+    BOOST_TEST(vertex->getName().find(prefix) == 0);
+  }
+  BOOST_TEST(first == np->getNamedVerticesPtr("^pipeline_module\\.g_pipestage\\[1\\]"));
+  BOOST_TEST(np->getNamedVerticesPage(prefix, count, 10).empty());
+  BOOST_TEST(np->getNumNamedVertices("foo") == 0);
+}
+
+/// Test queries with differently configured contexts in concurrent threads.
+BOOST_FIXTURE_TEST_CASE(query_contexts, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("pipeline_module.sv", "pipeline"));
+  bool matchWildcard = netlist_paths::Options::getInstance().getMatchWildcard();
+  netlist_paths::Options::getInstance().setMatchWildcard();
+  netlist_paths::QueryContext regexContext;
+  regexContext.setMatchRegex();
+  BOOST_TEST(!regexContext.getMatchWildcard());
+  {
+    netlist_paths::QueryScope scope(regexContext);
+    BOOST_TEST(np->regExists(".*d.t._q.*"));
+    BOOST_CHECK_THROW(np->regExists("*data_q"), netlist_paths::Exception);
+  }
+  // The global option applies again outside the scope.
+  BOOST_TEST(np->regExists("*d?t?_q*"));
+  BOOST_CHECK_THROW(regexContext.exit(), netlist_paths::Exception);
+  // Alternate the two modes between threads.
+  std::vector<int> results(4, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < results.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      netlist_paths::QueryContext context;
+      if (t % 2) {
+        context.setMatchRegex();
+      }
+      netlist_paths::QueryScope scope(context);
+      for (int i = 0; i < 100; ++i) {
+        auto pattern = t % 2 ? ".*d.t._q.*" : "*d?t?_q*";
+        results[t] += np->regExists(pattern) &&
+                      !np->getAllFanOut(std::string(pattern)).empty();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  BOOST_TEST(results == std::vector<int>(4, 100));
+  // The default context follows changes to the global options.
+  BOOST_TEST(netlist_paths::QueryContext::current().getMatchWildcard());
+  netlist_paths::Options::getInstance().setMatchRegex();
+  BOOST_TEST(!netlist_paths::QueryContext::current().getMatchWildcard());
+  if (matchWildcard) {
+    netlist_paths::Options::getInstance().setMatchWildcard();
+  }
+}
@@ -3,6 +3,7 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 
+#include <fstream>
 #include <boost/test/unit_test.hpp>
 #include "tests/definitions.hpp"
 #include "TestContext.hpp"
@@ -35,6 +36,83 @@ BOOST_FIXTURE_TEST_CASE(path_exists, TestContext) {
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(paths_exist, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("counter.sv"));
+  // Check a batch of queries gives the same answers as individual queries.
+  std::vector<netlist_paths::Waypoints> waypoints = {
+      netlist_paths::Waypoints("counter.i_clk", "counter.counter_q"),
+      netlist_paths::Waypoints("counter.i_clk", "counter.o_count"),
+      netlist_paths::Waypoints("counter.counter_q", "counter.o_count"),
+      netlist_paths::Waypoints("counter.i_rst", "counter.counter_q"),
+      netlist_paths::Waypoints("counter.i_rst", "counter.o_wrap"),
+      netlist_paths::Waypoints("counter.counter_q", "counter.o_wrap")};
+  auto results = np->pathsExist(waypoints);
+  BOOST_TEST(results.size() == waypoints.size());
+  for (std::size_t i = 0; i < waypoints.size(); ++i) {
+    BOOST_TEST(results[i] == np->pathExists(waypoints[i]));
+  }
+  BOOST_TEST(results == std::vector<bool>({true, false, true, true, false, true}),
+             boost::test_tools::per_element());
+  // Invalid start and finish points.
+  BOOST_CHECK_THROW(np->pathsExist({netlist_paths::Waypoints("counter.o_count", "counter.counter_q")}),
+                    netlist_paths::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(path_exists_reachability_index, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("pipeline_module.sv"));
+  std::vector<netlist_paths::Waypoints> waypoints = {
+      netlist_paths::Waypoints("i_data", "data_q"),
+      netlist_paths::Waypoints("data_q", "o_data"),
+      netlist_paths::Waypoints("i_data", "o_data"),
+      netlist_paths::Waypoints("g_pipestage\\[0\\].u_pipestage.data_q",
+                               "g_pipestage\\[1\\].u_pipestage.data_q"),
+      netlist_paths::Waypoints("g_pipestage\\[1\\].u_pipestage.data_q",
+                               "g_pipestage\\[0\\].u_pipestage.data_q")};
+  auto expected = np->pathsExist(waypoints);
+  // The index gives the same answers as searching.
+  BOOST_TEST(!np->hasReachabilityIndex());
+  np->buildReachabilityIndex();
+  BOOST_TEST(np->hasReachabilityIndex());
+  BOOST_TEST(np->pathsExist(waypoints) == expected, boost::test_tools::per_element());
+  for (std::size_t i = 0; i < waypoints.size(); ++i) {
+    BOOST_TEST(np->pathExists(waypoints[i]) == expected[i]);
+  }
+  // Save and reload the index.
+  auto indexFile = fs::unique_path();
+  np->saveReachabilityIndex(indexFile.native());
+  BOOST_CHECK_NO_THROW(np->loadReachabilityIndex(indexFile.native()));
+  BOOST_TEST(np->pathsExist(waypoints) == expected, boost::test_tools::per_element());
+  // Corrupt copies of the index are rejected: the length of the components
+  // (after a 40-byte header) is overlong, a component is out of range, or
+  // the file is truncated.
+  std::ifstream indexStream(indexFile.native(), std::ios::binary);
+  std::string index((std::istreambuf_iterator<char>(indexStream)),
+                    std::istreambuf_iterator<char>());
+  auto corruptFile = fs::unique_path();
+  auto loadCorrupt = [&](const std::string &contents) {
+    std::ofstream(corruptFile.native(), std::ios::binary) << contents;
+    BOOST_CHECK_THROW(np->loadReachabilityIndex(corruptFile.native()),
+                      netlist_paths::Exception);
+  };
+  auto overwrite = [&](std::size_t offset, uint64_t value, std::size_t size) {
+    auto contents = index;
+    contents.replace(offset, size, reinterpret_cast<const char*>(&value), size);
+    return contents;
+  };
+  loadCorrupt(overwrite(40, UINT64_MAX, sizeof(uint64_t)));
+  loadCorrupt(overwrite(48, UINT32_MAX, sizeof(uint32_t)));
+  loadCorrupt(index.substr(0, index.size() - 1));
+  fs::remove(corruptFile);
+  fs::remove(indexFile);
+  BOOST_CHECK_THROW(np->loadReachabilityIndex(indexFile.native()),
+                    netlist_paths::Exception);
+  // A failed write is reported.
+  if (fs::exists("/dev/full")) {
+    BOOST_CHECK_THROW(np->saveReachabilityIndex("/dev/full"),
+                      netlist_paths::Exception);
+  }
+}
+
 BOOST_FIXTURE_TEST_CASE(path_query_basic_assign_chain, TestContext) {
   BOOST_CHECK_NO_THROW(compile("basic_assign_chain.sv"));
   auto vertices = np->getAnyPath(netlist_paths::Waypoints("in", "out"));
@@ -135,6 +213,97 @@ BOOST_FIXTURE_TEST_CASE(path_all_paths, TestContext) {
   checkVarReport(paths[2][4], "VAR", "logic", "out");
 }
 
+BOOST_FIXTURE_TEST_CASE(path_avoid_points, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("multiple_paths.sv"));
+  // Avoid one of the paths.
+  auto waypoints = netlist_paths::Waypoints("in", "out");
+  waypoints.addAvoidPoint("multiple_paths.a");
+  BOOST_TEST(np->pathExists(waypoints));
+  auto path = np->getAnyPath(waypoints);
+  BOOST_TEST(path.size() == 5);
+  checkVarReport(path[2], "VAR", "logic", "multiple_paths.b");
+  auto paths = np->getAllPaths(waypoints);
+  BOOST_TEST(paths.size() == 2);
+  checkVarReport(paths[0][2], "VAR", "logic", "multiple_paths.b");
+  checkVarReport(paths[1][2], "VAR", "logic", "multiple_paths.c");
+  BOOST_TEST(np->pathsExist({waypoints}) == std::vector<bool>{true});
+  // Avoid all of the paths with a pattern.
+  waypoints.addAvoidPoint("multiple_paths.[bc]");
+  BOOST_TEST(!np->pathExists(waypoints));
+  BOOST_TEST(np->getAnyPath(waypoints).empty());
+  BOOST_TEST(np->getAllPaths(waypoints).empty());
+  BOOST_TEST(np->pathsExist({waypoints}) == std::vector<bool>{false});
+  // Avoid the start and finish points.
+  for (auto name : {"in", "out"}) {
+    auto endPointWaypoints = netlist_paths::Waypoints("in", "out");
+    endPointWaypoints.addAvoidPoint(name);
+    BOOST_TEST(!np->pathExists(endPointWaypoints));
+    BOOST_TEST(np->getAnyPath(endPointWaypoints).empty());
+    BOOST_TEST(np->getAllPaths(endPointWaypoints).empty());
+    BOOST_TEST(np->pathsExist({endPointWaypoints}) == std::vector<bool>{false});
+  }
+  // Avoid points must exist.
+  waypoints.addAvoidPoint("foo");
+  BOOST_CHECK_THROW(np->pathExists(waypoints), netlist_paths::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(path_inout_port, TestContext) {
+  // An inout port is both a start and a finish point, so a path can start and
+  // finish at it.
+  BOOST_CHECK_NO_THROW(compile("inout_port.sv"));
+  auto path = np->getAnyPath(netlist_paths::Waypoints("io", "io"));
+  BOOST_TEST(path.size() == 1);
+  checkVarReport(path[0], "VAR", "logic", "io");
+  // Likewise when avoid points are given.
+  auto waypoints = netlist_paths::Waypoints("io", "io");
+  waypoints.addAvoidPoint("o_b");
+  path = np->getAnyPath(waypoints);
+  BOOST_TEST(path.size() == 1);
+  checkVarReport(path[0], "VAR", "logic", "io");
+  // The port is connected to itself in a path matrix.
+  auto matrix = np->getPathMatrix("^io$", "^(io|o_b)$", true);
+  BOOST_TEST(matrix.startPoints.size() == 1);
+  BOOST_TEST(matrix.finishPoints.size() == 2);
+  for (std::size_t j = 0; j < 2; ++j) {
+    BOOST_TEST(matrix.connected[0][j]);
+    BOOST_TEST(matrix.paths[0][j].front()->getName() == "io");
+    BOOST_TEST(matrix.paths[0][j].back() == matrix.finishPoints[j]);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(path_matrix, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
+  // One start point to three registers.
+  auto matrix = np->getPathMatrix("in$", "fan_out_in.?", true);
+  BOOST_TEST(matrix.startPoints.size() == 1);
+  BOOST_TEST(matrix.finishPoints.size() == 3);
+  checkVarReport(matrix.startPoints[0], "VAR", "logic", "in");
+  checkVarReport(matrix.finishPoints[0], "DST_REG", "logic", "fan_out_in.a");
+  for (std::size_t j = 0; j < 3; ++j) {
+    BOOST_TEST(matrix.connected[0][j]);
+    BOOST_TEST(matrix.paths[0][j].size() == 3);
+  }
+  // Three registers to one end point, without paths.
+  matrix = np->getPathMatrix("fan_out_in.?", "out");
+  BOOST_TEST(matrix.startPoints.size() == 3);
+  BOOST_TEST(matrix.finishPoints.size() == 1);
+  checkVarReport(matrix.startPoints[0], "SRC_REG", "logic", "fan_out_in.a");
+  for (std::size_t i = 0; i < 3; ++i) {
+    BOOST_TEST(matrix.connected[i][0]);
+  }
+  BOOST_TEST(matrix.paths.empty());
+  // The registers are not connected to each other.
+  matrix = np->getPathMatrix("fan_out_in.[ab]", "fan_out_in.?");
+  BOOST_TEST(matrix.startPoints.size() == 2);
+  BOOST_TEST(matrix.finishPoints.size() == 3);
+  for (auto &row : matrix.connected) {
+    BOOST_TEST(std::none_of(row.begin(), row.end(), [](bool b) { return b; }));
+  }
+  // Patterns must match start and finish points.
+  BOOST_CHECK_THROW(np->getPathMatrix("foo", "out"), netlist_paths::Exception);
+  BOOST_CHECK_THROW(np->getPathMatrix("in", "foo"), netlist_paths::Exception);
+}
+
 BOOST_FIXTURE_TEST_CASE(path_fan_out, TestContext) {
   // Test paths fanning out to three end points.
   BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
@@ -167,6 +336,241 @@ BOOST_FIXTURE_TEST_CASE(path_fan_in, TestContext) {
   checkVarReport(paths[2][2], "VAR", "logic", "out");
 }
 
+BOOST_FIXTURE_TEST_CASE(path_fan_out_in_avoid_points, TestContext) {
+  // Test fan out and fan in paths do not pass through avoid points, with
+  // depth-first and breadth-first traversals.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
+  for (unsigned long threshold : {100000UL, 1UL}) {
+    netlist_paths::Options::getInstance().setBFSThreshold(threshold);
+    auto paths = np->getAllFanOut("in", {"fan_out_in.a"});
+    BOOST_TEST(paths.size() == 2);
+    checkVarReport(paths[0][2], "DST_REG", "logic", "fan_out_in.b");
+    checkVarReport(paths[1][2], "DST_REG", "logic", "fan_out_in.c");
+    paths = np->getAllFanIn("out", {"fan_out_in.[ab]"});
+    BOOST_TEST(paths.size() == 1);
+    checkVarReport(paths[0][0], "SRC_REG", "logic", "fan_out_in.c");
+    // Nothing fans out from an avoided start point.
+    BOOST_TEST(np->getAllFanOut("in", {"in"}).empty());
+    // Paths without avoid points are unaffected.
+    BOOST_TEST(np->getAllFanOut("in").size() == 3);
+    // Fan out and in of several points together.
+    auto fanOuts = np->getAllFanOutMulti({"in", "in"}, {"fan_out_in.a"});
+    BOOST_TEST(fanOuts.size() == 2);
+    BOOST_TEST(fanOuts[0] == np->getAllFanOut("in", {"fan_out_in.a"}));
+    BOOST_TEST(fanOuts[1] == fanOuts[0]);
+    auto fanIns = np->getAllFanInMulti({"out"}, {"fan_out_in.[ab]"});
+    BOOST_TEST(fanIns.size() == 1);
+    BOOST_TEST(fanIns[0] == np->getAllFanIn("out", {"fan_out_in.[ab]"}));
+    // Path matrices.
+    auto matrix = np->getPathMatrix("in$", "fan_out_in.?", true, {"fan_out_in.a"});
+    BOOST_TEST(matrix.connected[0] == std::vector<bool>({false, true, true}),
+               boost::test_tools::per_element());
+    BOOST_TEST(matrix.paths[0][0].empty());
+    checkVarReport(matrix.paths[0][1][2], "DST_REG", "logic", "fan_out_in.b");
+    matrix = np->getPathMatrix("fan_out_in.?", "out", true, {"fan_out_in.[ab]"});
+    BOOST_TEST(!matrix.connected[0][0]);
+    BOOST_TEST(!matrix.connected[1][0]);
+    BOOST_TEST(matrix.connected[2][0]);
+    checkVarReport(matrix.paths[2][0][0], "SRC_REG", "logic", "fan_out_in.c");
+  }
+  netlist_paths::Options::getInstance().setBFSThreshold(100000);
+  BOOST_CHECK_THROW(np->getAllFanOut("in", {"foo"}), netlist_paths::Exception);
+  BOOST_CHECK_THROW(np->getAllFanOutMulti({"in"}, {"foo"}), netlist_paths::Exception);
+  BOOST_CHECK_THROW(np->getPathMatrix("in", "out", false, {"foo"}),
+                    netlist_paths::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(path_fan_out_in_multi, TestContext) {
+  // Test fan out and fan in paths of several points together match those of
+  // each point separately.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in_modules.sv"));
+  netlist_paths::Options::getInstance().setNumThreads(2);
+  std::vector<std::string> startNames = {"in", "fan_out_in_modules.foo_b.x", "in"};
+  auto fanOuts = np->getAllFanOutMulti(startNames);
+  BOOST_TEST(fanOuts.size() == startNames.size());
+  for (size_t i = 0; i < startNames.size(); ++i) {
+    BOOST_TEST(fanOuts[i] == np->getAllFanOut(startNames[i]));
+  }
+  std::vector<std::string> finishNames = {"out", "fan_out_in_modules.foo_a.x"};
+  auto fanIns = np->getAllFanInMulti(finishNames);
+  BOOST_TEST(fanIns.size() == finishNames.size());
+  for (size_t i = 0; i < finishNames.size(); ++i) {
+    BOOST_TEST(fanIns[i] == np->getAllFanIn(finishNames[i]));
+  }
+  BOOST_CHECK_THROW(np->getAllFanOutMulti({"in", "foo"}), netlist_paths::Exception);
+  netlist_paths::Options::getInstance().setNumThreads(0);
+}
+
+BOOST_FIXTURE_TEST_CASE(path_fan_out_in_bfs, TestContext) {
+  // Test fan out and fan in paths found by breadth-first search, forced with
+  // a threshold of one vertex, have the same end points and are no longer.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in_modules.sv"));
+  auto check = [](const std::vector<std::vector<netlist_paths::Vertex*> > &dfsPaths,
+                  const std::vector<std::vector<netlist_paths::Vertex*> > &bfsPaths) {
+    BOOST_TEST(dfsPaths.size() == bfsPaths.size());
+    for (size_t i = 0; i < std::min(dfsPaths.size(), bfsPaths.size()); ++i) {
+      BOOST_TEST(dfsPaths[i].front() == bfsPaths[i].front());
+      BOOST_TEST(dfsPaths[i].back() == bfsPaths[i].back());
+      BOOST_TEST(bfsPaths[i].size() <= dfsPaths[i].size());
+    }
+  };
+  auto dfsFanOut = np->getAllFanOut("in");
+  auto dfsFanIn = np->getAllFanIn("out");
+  // Disable the traversal cache so the cached DFS results are not reused.
+  netlist_paths::Options::getInstance().setTraversalCacheSize(0);
+  netlist_paths::Options::getInstance().setBFSThreshold(1);
+  for (unsigned numThreads : {1, 4}) {
+    netlist_paths::Options::getInstance().setNumThreads(numThreads);
+    check(dfsFanOut, np->getAllFanOut("in"));
+    check(dfsFanIn, np->getAllFanIn("out"));
+  }
+  // A breadth-first search continuing an abandoned depth-first search finds
+  // paths with the same end points.
+  auto checkEnds = [](const std::vector<std::vector<netlist_paths::Vertex*> > &dfsPaths,
+                      const std::vector<std::vector<netlist_paths::Vertex*> > &paths) {
+    BOOST_TEST(dfsPaths.size() == paths.size());
+    for (size_t i = 0; i < std::min(dfsPaths.size(), paths.size()); ++i) {
+      BOOST_TEST(dfsPaths[i].front() == paths[i].front());
+      BOOST_TEST(dfsPaths[i].back() == paths[i].back());
+    }
+  };
+  netlist_paths::Options::getInstance().setBFSThreshold(3);
+  checkEnds(dfsFanOut, np->getAllFanOut("in"));
+  checkEnds(dfsFanIn, np->getAllFanIn("out"));
+  netlist_paths::Options::getInstance().setNumThreads(0);
+  netlist_paths::Options::getInstance().setBFSThreshold(100000);
+  netlist_paths::Options::getInstance().setTraversalCacheSize(64UL << 20);
+}
+
+BOOST_FIXTURE_TEST_CASE(traversal_cache, TestContext) {
+  // Test repeated queries from the same start point are answered from the
+  // traversal cache with the same results.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
+  np->clearTraversalCache();
+  auto fanOut = np->getAllFanOut("in");
+  auto stats = np->getTraversalCacheStats();
+  BOOST_TEST(stats.hits == 0);
+  BOOST_TEST(stats.misses == 1);
+  BOOST_TEST(stats.numEntries == 1);
+  BOOST_TEST(stats.numBytes > 0);
+  for (auto &path : fanOut) {
+    auto waypoints = netlist_paths::Waypoints("in", path.back()->getName());
+    BOOST_TEST(np->getAnyPath(waypoints) == path);
+  }
+  BOOST_TEST(np->getAllFanOut("in") == fanOut);
+  BOOST_TEST(np->getFanOutDegree("in") == 3);
+  stats = np->getTraversalCacheStats();
+  BOOST_TEST(stats.hits == 5);
+  BOOST_TEST(stats.misses == 1);
+  // A capacity too small for any result disables caching.
+  netlist_paths::Options::getInstance().setTraversalCacheSize(1);
+  BOOST_TEST(np->getAllFanIn("out").size() == 3);
+  BOOST_TEST(np->getTraversalCacheStats().numEntries == 0);
+  netlist_paths::Options::getInstance().setTraversalCacheSize(64UL << 20);
+  // So does a capacity of zero in a query context.
+  {
+    netlist_paths::QueryContext context;
+    context.setTraversalCacheSize(0);
+    netlist_paths::QueryScope scope(context);
+    BOOST_TEST(np->getAllFanIn("out").size() == 3);
+    BOOST_TEST(np->getTraversalCacheStats().numEntries == 0);
+  }
+  BOOST_TEST(np->getAllFanIn("out").size() == 3);
+  BOOST_TEST(np->getTraversalCacheStats().numEntries == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(name_index_scopes, TestContext) {
+  // Test the vertices and instances within a scope are found by hierarchical
+  // prefix.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in_modules.sv"));
+  BOOST_TEST(np->getChildScopes("") == std::vector<std::string>{"fan_out_in_modules"});
+  BOOST_TEST(np->getChildScopes("fan_out_in_modules") ==
+             std::vector<std::string>({"foo_a", "foo_b", "foo_c"}));
+  BOOST_TEST(np->getChildScopes("fan_out_in_modules.foo_a").empty());
+  BOOST_TEST(np->getChildScopes("bar").empty());
+  auto vertices = np->getVerticesInScope("fan_out_in_modules.foo_a");
+  BOOST_TEST(vertices.size() > 0);
+  bool foundReg = false;
+  for (auto vertex : vertices) {
+    BOOST_TEST(vertex->getName().find("fan_out_in_modules.foo_a.") == 0);
+    foundReg |= vertex->getName() == "fan_out_in_modules.foo_a.x";
+  }
+  BOOST_TEST(foundReg);
+  BOOST_TEST(np->getVerticesInScope("fan_out_in_modules/foo_a") == vertices);
+  BOOST_TEST(np->getVerticesInScope("fan_out_in_modules.foo").empty());
+  BOOST_TEST(np->getVerticesInScope("").size() == np->getNamedVertices().size());
+}
+
+BOOST_FIXTURE_TEST_CASE(instance_hierarchy, TestContext) {
+  // Test queries scoped to an instance of the hierarchy.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in_modules.sv"));
+  auto registers = np->getRegistersInScope("fan_out_in_modules.foo_b");
+  BOOST_TEST(registers.size() == 1);
+  checkVarReport(registers[0], "DST_REG", "logic", "fan_out_in_modules.foo_b.x");
+  BOOST_TEST(np->getRegistersInScope("fan_out_in_modules").size() == 3);
+  BOOST_TEST(np->getRegistersInScope("bar").empty());
+  auto paths = np->getPathsLeavingScope("fan_out_in_modules.foo_b");
+  BOOST_TEST(paths.size() > 0);
+  for (auto &path : paths) {
+    BOOST_TEST(path.front()->getName().find("fan_out_in_modules.foo_b.") == 0);
+    BOOST_TEST(path.back()->getName().find("fan_out_in_modules.foo_b.") != 0);
+  }
+  BOOST_TEST(np->getPathsLeavingScope("fan_out_in_modules").empty());
+  // Top-level ports and variables are start and finish points.
+  BOOST_TEST(np->startpointExists("in"));
+  BOOST_TEST(np->endpointExists("out"));
+  BOOST_TEST(!np->startpointExists("fan_out_in_modules.foo_b.in"));
+}
+
+BOOST_FIXTURE_TEST_CASE(path_arrays, TestContext) {
+  // Test the columnar exports agree with the vertex paths.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
+  auto paths = np->getAllFanOut("in");
+  auto arrays = netlist_paths::Netlist::createPathArrays(np->getAllFanOutIds("in"));
+  BOOST_TEST(arrays.offsets.size() == paths.size() + 1);
+  BOOST_TEST(arrays.offsets.back() == arrays.vertices.size());
+  auto table = np->getVertexTable();
+  BOOST_TEST(table.nameOffsets.size() == np->numVertices() + 1);
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    BOOST_TEST(arrays.offsets[i + 1] - arrays.offsets[i] == paths[i].size());
+    for (std::size_t j = 0; j < paths[i].size(); ++j) {
+      auto vertex = arrays.vertices[arrays.offsets[i] + j];
+      BOOST_TEST(np->getVertex(vertex) == paths[i][j]);
+      auto name = table.names.substr(table.nameOffsets[vertex],
+                                     table.nameOffsets[vertex + 1] -
+                                     table.nameOffsets[vertex]);
+      BOOST_TEST(name == paths[i][j]->getName());
+      BOOST_TEST(table.astTypes[vertex] ==
+                 static_cast<uint8_t>(paths[i][j]->getAstType()));
+      BOOST_TEST(table.widths[vertex] == paths[i][j]->getDTypeWidth());
+    }
+  }
+  BOOST_CHECK_THROW(np->getVertex(np->numVertices()), netlist_paths::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(path_enumerators, TestContext) {
+  // Test the enumerators produce the same paths as the complete queries.
+  BOOST_CHECK_NO_THROW(compile("multiple_paths.sv"));
+  auto collect = [](netlist_paths::PathEnumerator &enumerator) {
+    std::vector<netlist_paths::VertexIDVec> paths;
+    netlist_paths::VertexIDVec path;
+    while (enumerator.next(path)) {
+      paths.push_back(path);
+    }
+    BOOST_TEST(!enumerator.next(path));
+    return paths;
+  };
+  auto waypoints = netlist_paths::Waypoints("in", "out");
+  auto paths = collect(*np->getAllPathsEnumerator(waypoints));
+  BOOST_TEST(paths.size() == 3);
+  BOOST_TEST(paths == np->getAllPathsIds(waypoints));
+  waypoints.addAvoidPoint("multiple_paths.b");
+  BOOST_TEST(collect(*np->getAllPathsEnumerator(waypoints)).size() == 2);
+  BOOST_TEST(collect(*np->getAllFanOutEnumerator("in")) == np->getAllFanOutIds("in"));
+  BOOST_TEST(collect(*np->getAllFanInEnumerator("out")) == np->getAllFanInIds("out"));
+  BOOST_CHECK_THROW(np->getAllFanOutEnumerator("foo"), netlist_paths::Exception);
+}
+
 BOOST_FIXTURE_TEST_CASE(path_fan_out_modules, TestContext) {
   // Test fan out paths ending in sub modules.
   BOOST_CHECK_NO_THROW(compile("fan_out_in_modules.sv"));
@@ -205,3 +609,152 @@ BOOST_FIXTURE_TEST_CASE(path_fan_in_modules, TestContext) {
   checkVarReport(paths[2][5], "VAR", "logic", "out");
 }
 
+
+BOOST_FIXTURE_TEST_CASE(fan_out_in_degree, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
+  BOOST_TEST(np->getFanOutDegree("in") == 3);
+  BOOST_TEST(np->getFanInDegree("out") == 3);
+  BOOST_CHECK_THROW(np->getFanOutDegree("foo"), netlist_paths::Exception);
+  // The degrees of all points match those of single points, and both sweeps
+  // count the same connected pairs.
+  size_t fanOutTotal = 0;
+  for (auto &degree : np->getAllFanOutDegrees()) {
+    BOOST_TEST(degree.first->isStartPoint());
+    fanOutTotal += degree.second;
+    if (degree.first->getName() == "fan_out_in.a") {
+      BOOST_TEST(degree.second == np->getAllFanOut("fan_out_in.a").size());
+    }
+  }
+  size_t fanInTotal = 0;
+  for (auto &degree : np->getAllFanInDegrees()) {
+    BOOST_TEST(degree.first->isFinishPoint());
+    fanInTotal += degree.second;
+    if (degree.first->getName() == "out") {
+      BOOST_TEST(degree.second == np->getFanInDegree("out"));
+    }
+  }
+  BOOST_TEST(fanOutTotal == fanInTotal);
+  BOOST_TEST(fanOutTotal > 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(logic_depth, TestContext) {
+  // A chain of three assignments.
+  BOOST_CHECK_NO_THROW(compile("basic_assign_chain.sv"));
+  BOOST_TEST(np->getLogicDepth("out") == 3);
+  auto paths = np->getDeepestPaths(1);
+  BOOST_TEST(paths.size() == 1);
+  BOOST_TEST(paths[0].size() == 7);
+  checkVarReport(paths[0][0], "VAR", "logic", "in");
+  checkVarReport(paths[0][6], "VAR", "logic", "out");
+  // Each register is one assignment from its start point.
+  BOOST_CHECK_NO_THROW(compile("basic_ff_chain.sv"));
+  auto depths = np->getAllLogicDepths();
+  BOOST_TEST(depths.size() == 3);
+  for (auto &depth : depths) {
+    BOOST_TEST(depth.second == 1);
+  }
+  BOOST_TEST(np->getDeepestPaths(10).size() == 3);
+  BOOST_TEST(np->getDeepestPaths(0).empty());
+  BOOST_TEST(np->getLogicDepthHistogram() == std::vector<size_t>({0, 3}),
+             boost::test_tools::per_element());
+  size_t numFinishPoints = 0;
+  for (auto &module : np->getLogicDepthModuleStats()) {
+    numFinishPoints += module.numFinishPoints;
+    if (module.name == "basic_ff_chain") {
+      BOOST_TEST(module.numFinishPoints == 2);
+      BOOST_TEST(module.maxDepth == 1);
+    }
+  }
+  BOOST_TEST(numFinishPoints == 3);
+  // Paths through combinational loops have no depth.
+  BOOST_CHECK_NO_THROW(compile("comb_loop.sv"));
+  BOOST_TEST(np->getLogicDepth("o_b") == -1);
+  BOOST_CHECK_THROW(np->getLogicDepth("foo"), netlist_paths::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(register_graph, TestContext) {
+  auto names = [](const std::vector<netlist_paths::Vertex*> &vertices) {
+    std::vector<std::string> result;
+    for (auto vertex : vertices) {
+      result.push_back(vertex->getName());
+    }
+    std::sort(std::begin(result), std::end(result));
+    return result;
+  };
+  // Registers fanning out from and in to a port.
+  BOOST_CHECK_NO_THROW(compile("fan_out_in.sv"));
+  auto fanOut = np->getRegisterFanOut("in");
+  BOOST_TEST(names(fanOut) == std::vector<std::string>({"fan_out_in.a",
+                                                        "fan_out_in.b",
+                                                        "fan_out_in.c"}),
+             boost::test_tools::per_element());
+  for (auto vertex : fanOut) {
+    BOOST_TEST(vertex->getAstTypeStr() == "DST_REG");
+  }
+  auto fanIn = np->getRegisterFanIn("out");
+  BOOST_TEST(names(fanIn) == std::vector<std::string>({"fan_out_in.a",
+                                                       "fan_out_in.b",
+                                                       "fan_out_in.c"}),
+             boost::test_tools::per_element());
+  for (auto vertex : fanIn) {
+    BOOST_TEST(vertex->getAstTypeStr() == "SRC_REG");
+  }
+  BOOST_CHECK_THROW(np->getRegisterFanOut("foo"), netlist_paths::Exception);
+  // Pipeline depth along a chain of registers.
+  BOOST_CHECK_NO_THROW(compile("basic_ff_chain.sv"));
+  BOOST_TEST(np->getPipelineDepth("basic_ff_chain.a") == 1);
+  BOOST_TEST(np->getPipelineDepth("basic_ff_chain.b") == 2);
+  BOOST_TEST(np->getPipelineDepth("out") == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(extract_cone, TestContext) {
+  BOOST_CHECK_NO_THROW(compile("fan_out_in_modules.sv"));
+  auto names = [](const std::vector<std::vector<netlist_paths::Vertex*> > &paths) {
+    std::vector<std::string> result;
+    for (auto &path : paths) {
+      for (auto vertex : path) {
+        result.push_back(vertex->getName());
+      }
+    }
+    return result;
+  };
+  // The fan in cone of an output contains the same fan in paths.
+  auto cone = np->extractCone({"out"}, true, false);
+  BOOST_TEST(cone->numVertices() < np->numVertices());
+  BOOST_TEST(names(cone->getAllFanIn("out")) == names(np->getAllFanIn("out")),
+             boost::test_tools::per_element());
+  // The fan out cone of a register contains no paths into it.
+  cone = np->extractCone({"fan_out_in_modules.foo_a.x"}, false, true);
+  BOOST_TEST(names(cone->getAllFanOut("fan_out_in_modules.foo_a.x")) ==
+             names(np->getAllFanOut("fan_out_in_modules.foo_a.x")),
+             boost::test_tools::per_element());
+  BOOST_CHECK_THROW(cone->getAllFanIn("fan_out_in_modules.foo_a.x"), netlist_paths::Exception);
+  BOOST_CHECK_THROW(np->extractCone({"foo"}, true, true), netlist_paths::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(comb_loops, TestContext) {
+  // Designs without combinational loops.
+  BOOST_CHECK_NO_THROW(compile("adder.sv"));
+  BOOST_TEST(np->getCombLoops().empty());
+  BOOST_CHECK_NO_THROW(compile("basic_comb_chain.sv"));
+  BOOST_TEST(np->getCombLoops().empty());
+  // A loop between two variables, via two assignments.
+  BOOST_CHECK_NO_THROW(compile("comb_loop.sv"));
+  auto loops = np->getCombLoops();
+  BOOST_TEST(loops.size() == 1);
+  std::vector<std::string> names;
+  size_t numLogic = 0;
+  for (auto vertex : loops[0]) {
+    if (vertex->isLogic()) {
+      numLogic++;
+    } else {
+      names.push_back(vertex->getName());
+    }
+  }
+  std::sort(std::begin(names), std::end(names));
+  BOOST_TEST(names == std::vector<std::string>({"comb_loop.x", "comb_loop.y"}),
+             boost::test_tools::per_element());
+  BOOST_TEST(numLogic == 2);
+  // Paths through the loop are still found.
+  BOOST_TEST(np->pathExists(netlist_paths::Waypoints("i_a", "o_b")));
+}
@@ -1,9 +1,11 @@
 import os
 import sys
+import tempfile
 import unittest
+from concurrent.futures import ThreadPoolExecutor
 import definitions as defs
 sys.path.insert(0, os.path.join(defs.BINARY_DIR_PREFIX, 'lib', 'netlist_paths'))
-from py_netlist_paths import RunVerilator, Netlist, Waypoints, Options
+from py_netlist_paths import RunVerilator, Netlist, Waypoints, Options, QueryContext
 
 class TestPyWrapper(unittest.TestCase):
 
@@ -82,6 +84,37 @@ class TestPyWrapper(unittest.TestCase):
         self.assertFalse(np.path_exists(Waypoints('counter.i_rst', 'counter.o_wrap')))
         # TODO: check --from o_counter has no fan out paths
 
+    def test_counter_paths_exist(self):
+        np = self.compile_test('counter.sv')
+        waypoints = [Waypoints('counter.i_clk', 'counter.counter_q'),
+                     Waypoints('counter.i_clk', 'counter.o_count'),
+                     Waypoints('counter.counter_q', 'counter.o_count'),
+                     Waypoints('counter.i_rst', 'counter.o_wrap')]
+        self.assertEqual(np.paths_exist(waypoints), [True, False, True, False])
+        self.assertEqual(np.paths_exist([]), [])
+        self.assertRaises(RuntimeError, np.paths_exist, [Waypoints('counter.o_count', 'counter.i_clk')])
+
+    def test_counter_reachability_index(self):
+        np = self.compile_test('counter.sv')
+        waypoints = [Waypoints('counter.i_clk', 'counter.counter_q'),
+                     Waypoints('counter.i_clk', 'counter.o_count'),
+                     Waypoints('counter.counter_q', 'counter.o_count'),
+                     Waypoints('counter.i_rst', 'counter.o_wrap')]
+        with tempfile.TemporaryDirectory() as temp_dir:
+            index = os.path.join(temp_dir, 'netlist.idx')
+            self.assertFalse(np.has_reachability_index())
+            self.assertRaises(RuntimeError, np.save_reachability_index, index)
+            np.build_reachability_index()
+            self.assertTrue(np.has_reachability_index())
+            self.assertEqual(np.paths_exist(waypoints), [True, False, True, False])
+            np.save_reachability_index(index)
+            np = self.compile_test('counter.sv')
+            np.load_reachability_index(index)
+            self.assertEqual([np.path_exists(w) for w in waypoints], [True, False, True, False])
+            # An index does not match a different netlist.
+            np = self.compile_test('adder.sv')
+            self.assertRaises(RuntimeError, np.load_reachability_index, index)
+
     def test_pipeline_module_regs(self):
         np = self.compile_test('pipeline_module.sv')
         # Register path variations
@@ -128,6 +161,97 @@ class TestPyWrapper(unittest.TestCase):
         Options.get_instance().set_match_regex()
         # ...
 
+    def test_fan_out_in_multi(self):
+        np = self.compile_test('fan_out_in.sv')
+        names = lambda paths: [[v.get_name() for v in path] for path in paths]
+        fanouts = np.get_all_fanout_paths_multi(['in', 'fan_out_in.a'])
+        self.assertEqual(len(fanouts), 2)
+        self.assertEqual(names(fanouts[0]), names(np.get_all_fanout_paths('in')))
+        self.assertEqual(names(fanouts[1]), names(np.get_all_fanout_paths('fan_out_in.a')))
+        fanins = np.get_all_fanin_paths_multi(['out'])
+        self.assertEqual(names(fanins[0]), names(np.get_all_fanin_paths('out')))
+        self.assertRaises(RuntimeError, np.get_all_fanout_paths_multi, ['foo'])
+
+    def test_fan_out_in_bfs(self):
+        np = self.compile_test('fan_out_in_modules.sv')
+        ends = lambda paths: [(p[0].get_name(), p[-1].get_name()) for p in paths]
+        fanout = ends(np.get_all_fanout_paths('in'))
+        fanin = ends(np.get_all_fanin_paths('out'))
+        Options.get_instance().set_traversal_cache_size(0)
+        Options.get_instance().set_bfs_threshold(1)
+        self.assertEqual(ends(np.get_all_fanout_paths('in')), fanout)
+        self.assertEqual(ends(np.get_all_fanin_paths('out')), fanin)
+        Options.get_instance().set_bfs_threshold(100000)
+        Options.get_instance().set_traversal_cache_size(64 << 20)
+
+    def test_traversal_cache(self):
+        np = self.compile_test('fan_out_in.sv')
+        np.clear_traversal_cache()
+        paths = np.get_all_fanout_paths('in')
+        for path in paths:
+            any_path = np.get_any_path(Waypoints('in', path[-1].get_name()))
+            self.assertEqual([v.get_name() for v in any_path],
+                             [v.get_name() for v in path])
+        hits, misses, entries, size = np.get_traversal_cache_stats()
+        self.assertEqual((hits, misses, entries), (3, 1, 1))
+        self.assertTrue(size > 0)
+        # A query context can disable caching.
+        with QueryContext() as context:
+            context.set_traversal_cache_size(0)
+            np.get_all_fanin_paths('out')
+        self.assertEqual(np.get_traversal_cache_stats()[2], 1)
+
+    def test_fan_out_in_degree(self):
+        np = self.compile_test('fan_out_in.sv')
+        self.assertEqual(np.get_fanout_degree('in'), 3)
+        self.assertEqual(np.get_fanin_degree('out'), 3)
+        fanout = dict((v.get_name(), d) for v, d in np.get_all_fanout_degrees()
+                      if v.get_ast_type() == 'SRC_REG')
+        self.assertEqual(sorted(fanout.keys()), ['fan_out_in.a', 'fan_out_in.b', 'fan_out_in.c'])
+        self.assertEqual(fanout['fan_out_in.a'], len(np.get_all_fanout_paths('fan_out_in.a')))
+        total = sum(d for _, d in np.get_all_fanin_degrees())
+        self.assertEqual(total, sum(d for _, d in np.get_all_fanout_degrees()))
+
+    def test_logic_depth(self):
+        np = self.compile_test('basic_assign_chain.sv')
+        self.assertEqual(np.get_logic_depth('out'), 3)
+        paths = np.get_deepest_paths(1)
+        self.assertEqual(len(paths), 1)
+        self.assertEqual(paths[0][0].get_name(), 'in')
+        self.assertEqual(paths[0][-1].get_name(), 'out')
+        self.assertEqual(dict((v.get_name(), d) for v, d in np.get_all_logic_depths()), {'out': 3})
+        self.assertEqual(np.get_logic_depth_histogram(), [0, 0, 0, 1])
+        np = self.compile_test('basic_ff_chain.sv')
+        stats = dict((m, (n, d)) for m, n, d, _ in np.get_module_depth_stats())
+        self.assertEqual(stats['basic_ff_chain'], (2, 1))
+
+    def test_register_graph(self):
+        np = self.compile_test('fan_out_in.sv')
+        names = sorted(v.get_name() for v in np.get_register_fanout('in'))
+        self.assertEqual(names, ['fan_out_in.a', 'fan_out_in.b', 'fan_out_in.c'])
+        names = sorted(v.get_name() for v in np.get_register_fanin('out'))
+        self.assertEqual(names, ['fan_out_in.a', 'fan_out_in.b', 'fan_out_in.c'])
+        np = self.compile_test('basic_ff_chain.sv')
+        self.assertEqual(np.get_pipeline_depth('basic_ff_chain.b'), 2)
+        self.assertEqual(np.get_pipeline_depth('out'), 2)
+
+    def test_extract_cone(self):
+        np = self.compile_test('fan_out_in_modules.sv')
+        names = lambda paths: [[v.get_name() for v in path] for path in paths]
+        cone = np.extract_cone(['out'], True, False)
+        self.assertTrue(cone.num_vertices() < np.num_vertices())
+        self.assertEqual(names(cone.get_all_fanin_paths('out')), names(np.get_all_fanin_paths('out')))
+        self.assertRaises(RuntimeError, np.extract_cone, ['foo'], True, True)
+
+    def test_comb_loops(self):
+        np = self.compile_test('adder.sv')
+        self.assertEqual(len(np.get_comb_loops()), 0)
+        np = self.compile_test('comb_loop.sv')
+        loops = np.get_comb_loops()
+        self.assertEqual(len(loops), 1)
+        names = sorted(v.get_name() for v in loops[0] if v.get_ast_type() == 'VAR')
+        self.assertEqual(names, ['comb_loop.x', 'comb_loop.y'])
+
     def test_dtypes(self):
         # Check dtype queries (see C++ unit tests for complete set).
         np = self.compile_test('dtypes.sv')
@@ -160,6 +284,117 @@ class TestPyWrapper(unittest.TestCase):
         self.assertTrue(len(paths) == 3)
         # TODO: check the paths
 
+    def test_path_avoid_points(self):
+        np = self.compile_test('multiple_paths.sv')
+        waypoints = Waypoints('in', 'out')
+        waypoints.add_avoid_point('multiple_paths.a')
+        self.assertTrue(np.path_exists(waypoints))
+        self.assertEqual(np.get_any_path(waypoints)[2].get_name(), 'multiple_paths.b')
+        self.assertEqual(len(np.get_all_paths(waypoints)), 2)
+        waypoints.add_avoid_point('multiple_paths.[bc]')
+        self.assertFalse(np.path_exists(waypoints))
+        self.assertEqual(len(np.get_all_paths(waypoints)), 0)
+        # Avoid the start point.
+        waypoints = Waypoints('in', 'out')
+        waypoints.add_avoid_point('in')
+        self.assertFalse(np.path_exists(waypoints))
+        self.assertEqual(len(np.get_all_paths(waypoints)), 0)
+        self.assertEqual(len(list(np.iter_all_paths(waypoints))), 0)
+
+    def test_path_matrix(self):
+        np = self.compile_test('fan_out_in.sv')
+        starts, finishes, connected, paths = np.get_path_matrix('fan_out_in.?', 'out', True)
+        self.assertEqual([v.get_name() for v in starts],
+                         ['fan_out_in.a', 'fan_out_in.b', 'fan_out_in.c'])
+        self.assertEqual([v.get_name() for v in finishes], ['out'])
+        self.assertEqual(connected, [[True], [True], [True]])
+        self.assertEqual(paths[1][0][0].get_name(), 'fan_out_in.b')
+        starts, finishes, connected, paths = np.get_path_matrix('in$', 'fan_out_in.?')
+        self.assertEqual(connected, [[True, True, True]])
+        self.assertEqual(paths, [])
+
+    def test_name_index_scopes(self):
+        np = self.compile_test('fan_out_in_modules.sv')
+        self.assertEqual(np.get_child_scopes('fan_out_in_modules'),
+                         ['foo_a', 'foo_b', 'foo_c'])
+        names = [v.get_name() for v in np.get_vertices_in_scope('fan_out_in_modules.foo_b')]
+        self.assertTrue('fan_out_in_modules.foo_b.x' in names)
+        self.assertTrue(all(x.startswith('fan_out_in_modules.foo_b.') for x in names))
+
+    def test_instance_hierarchy(self):
+        np = self.compile_test('fan_out_in_modules.sv')
+        registers = np.get_registers_in_scope('fan_out_in_modules.foo_c')
+        self.assertEqual([v.get_name() for v in registers], ['fan_out_in_modules.foo_c.x'])
+        paths = np.get_paths_leaving_scope('fan_out_in_modules.foo_c')
+        self.assertTrue(len(paths) > 0)
+        for path in paths:
+            self.assertTrue(path[0].get_name().startswith('fan_out_in_modules.foo_c.'))
+            self.assertFalse(path[-1].get_name().startswith('fan_out_in_modules.foo_c.'))
+
+    def test_path_arrays(self):
+        np = self.compile_test('fan_out_in.sv')
+        paths = np.get_all_fanout_paths('in')
+        offsets, vertices = np.get_all_fanout_arrays('in')
+        self.assertEqual(len(offsets), len(paths) + 1)
+        table = np.get_vertex_table()
+        for i, path in enumerate(paths):
+            ids = vertices[offsets[i]:offsets[i+1]].tolist()
+            self.assertEqual([np.get_vertex(x).get_name() for x in ids],
+                             [v.get_name() for v in path])
+            for vertex_id, vertex in zip(ids, path):
+                begin, end = table['name_offsets'][vertex_id], table['name_offsets'][vertex_id+1]
+                self.assertEqual(table['names'][begin:end].decode(), vertex.get_name())
+                self.assertEqual(table['ast_type_names'][table['ast_type'][vertex_id]],
+                                 vertex.get_ast_type())
+        path = np.get_any_path_array(Waypoints('in', 'out'))
+        self.assertEqual(np.get_vertex(path[0]).get_name(), 'in')
+        self.assertEqual(np.get_vertex(path[-1]).get_name(), 'out')
+
+    def test_concurrent_queries(self):
+        np = self.compile_test('pipeline_module.sv')
+        def query(i):
+            name = 'g_pipestage\\[{}\\].u_pipestage.data_q'.format(i)
+            return ([[v.get_name() for v in path] for path in np.get_all_fanout_paths(name)],
+                    np.get_fanout_degree(name),
+                    np.path_exists(Waypoints('i_data', name)))
+        expected = [query(i) for i in range(8)]
+        np.clear_traversal_cache()
+        with ThreadPoolExecutor(4) as executor:
+            results = list(executor.map(query, list(range(8)) * 4))
+        self.assertEqual(results, expected * 4)
+
+    def test_query_context(self):
+        np = self.compile_test('pipeline_module.sv')
+        Options.get_instance().set_match_wildcard()
+        def query(regex):
+            context = QueryContext()
+            if regex:
+                context.set_match_regex()
+            with context:
+                return np.reg_exists('.*d.t._q.*' if regex else '*d?t?_q*')
+        with ThreadPoolExecutor(4) as executor:
+            results = list(executor.map(query, [False, True] * 8))
+        self.assertEqual(results, [True] * 16)
+        # The global option applies outside the context.
+        with QueryContext() as context:
+            context.set_match_regex()
+            self.assertRaises(RuntimeError, np.reg_exists, '*data_q')
+        self.assertTrue(np.reg_exists('*data_q*'))
+
+    def test_path_iterators(self):
+        np = self.compile_test('multiple_paths.sv')
+        names = lambda paths: [[v.get_name() for v in path] for path in paths]
+        waypoints = Waypoints('in', 'out')
+        self.assertEqual(names(np.iter_all_paths(waypoints)),
+                         names(np.get_all_paths(waypoints)))
+        self.assertEqual(names(np.iter_all_fanout_paths('in')),
+                         names(np.get_all_fanout_paths('in')))
+        self.assertEqual(names(np.iter_all_fanin_paths('out')),
+                         names(np.get_all_fanin_paths('out')))
+        # Stop after the first path.
+        first = next(iter(np.iter_all_paths(waypoints)))
+        self.assertEqual(first[0].get_name(), 'in')
+
     def test_path_all_fanout(self):
         np = self.compile_test('fan_out_in.sv')
         paths = np.get_all_fanout_paths('in')
@@ -172,6 +407,42 @@ class TestPyWrapper(unittest.TestCase):
         self.assertTrue(len(paths) == 3)
         # TODO: check the paths
 
+    def test_path_fan_out_in_avoid_points(self):
+        np = self.compile_test('fan_out_in.sv')
+        ends = lambda paths: [path[-1].get_name() for path in paths]
+        starts = lambda paths: [path[0].get_name() for path in paths]
+        self.assertEqual(ends(np.get_all_fanout_paths('in', ['fan_out_in.a'])),
+                         ['fan_out_in.b', 'fan_out_in.c'])
+        self.assertEqual(ends(np.iter_all_fanout_paths('in', ['fan_out_in.a'])),
+                         ['fan_out_in.b', 'fan_out_in.c'])
+        self.assertEqual(starts(np.get_all_fanin_paths('out', ['fan_out_in.[ab]'])),
+                         ['fan_out_in.c'])
+        self.assertEqual(starts(np.iter_all_fanin_paths('out', ['fan_out_in.[ab]'])),
+                         ['fan_out_in.c'])
+        # Fan out and in of several points together.
+        self.assertEqual([ends(paths) for paths in
+                          np.get_all_fanout_paths_multi(['in', 'in'], ['fan_out_in.a'])],
+                         [['fan_out_in.b', 'fan_out_in.c']] * 2)
+        self.assertEqual([starts(paths) for paths in
+                          np.get_all_fanin_paths_multi(['out'], ['fan_out_in.[ab]'])],
+                         [['fan_out_in.c']])
+        # Columnar exports.
+        ids = lambda paths: [[np.get_vertex(v).get_name() for v in paths[1][paths[0][i]:paths[0][i+1]]]
+                             for i in range(len(paths[0]) - 1)]
+        self.assertEqual([path[-1] for path in ids(np.get_all_fanout_arrays('in', ['fan_out_in.a']))],
+                         ['fan_out_in.b', 'fan_out_in.c'])
+        self.assertEqual([path[0] for path in ids(np.get_all_fanin_arrays('out', ['fan_out_in.[ab]']))],
+                         ['fan_out_in.c'])
+        # Path matrices.
+        _, _, connected, paths = np.get_path_matrix('in$', 'fan_out_in.?', True, ['fan_out_in.a'])
+        self.assertEqual(connected, [[False, True, True]])
+        self.assertEqual(ends(paths[0][1:]), ['fan_out_in.b', 'fan_out_in.c'])
+        _, _, connected, _ = np.get_path_matrix('fan_out_in.?', 'out', False, ['fan_out_in.[ab]'])
+        self.assertEqual(connected, [[False], [False], [True]])
+        self.assertRaises(RuntimeError, np.get_all_fanout_paths, 'in', ['foo'])
+        self.assertRaises(RuntimeError, np.get_all_fanout_paths_multi, ['in'], ['foo'])
+        self.assertRaises(RuntimeError, np.get_path_matrix, 'in', 'out', False, ['foo'])
+
 
 if __name__ == '__main__':
     unittest.main()
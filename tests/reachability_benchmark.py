@@ -0,0 +1,119 @@
+"""
+Compare the time taken to answer path existence queries with a reachability
+index and by searching the netlist graph, on a generated design or a given
+netlist. The answers of the two methods are checked to be the same.
+
+Usage: python3 reachability_benchmark.py [--registers N] [--queries N] [netlist.xml]
+"""
+import argparse
+import os
+import random
+import sys
+import tempfile
+import time
+import definitions as defs
+sys.path.insert(0, os.path.join(defs.BINARY_DIR_PREFIX, 'lib', 'netlist_paths'))
+from py_netlist_paths import RunVerilator, Netlist, Waypoints, Options
+
+# Write a design with a number of registers, each driven through a cone of
+# random combinational logic from the inputs and the other registers.
+def generate_design(filename, num_registers, num_ports, fan_in, rng):
+    inputs = ['i_{}'.format(i) for i in range(num_ports)]
+    outputs = ['o_{}'.format(i) for i in range(num_ports)]
+    registers = ['r_{}'.format(i) for i in range(num_registers)]
+    wires = ['w_{}'.format(i) for i in range(num_registers * 3)]
+    with open(filename, 'w') as f:
+        ports = ['input logic i_clk'] + \
+                ['input logic '+x for x in inputs] + \
+                ['output logic '+x for x in outputs]
+        f.write('module bench (\n  {});\n'.format(',\n  '.join(ports)))
+        for name in registers + wires:
+            f.write('  logic {};\n'.format(name))
+        drivers = inputs + registers
+        for wire in wires:
+            operands = rng.sample(drivers, min(fan_in, len(drivers)))
+            f.write('  assign {} = {};\n'.format(wire, ' ^ '.join(operands)))
+            drivers.append(wire)
+        f.write('  always_ff @(posedge i_clk) begin\n')
+        for register in registers:
+            f.write('    {} <= {};\n'.format(register, rng.choice(wires)))
+        f.write('  end\n')
+        for output in outputs:
+            f.write('  assign {} = {};\n'.format(output, rng.choice(wires)))
+        f.write('endmodule\n')
+
+# Return the answers to path existence queries and the time taken per query.
+def time_queries(netlist, pairs):
+    waypoints = [Waypoints(start, finish) for start, finish in pairs]
+    start = time.perf_counter()
+    answers = [netlist.path_exists(w) for w in waypoints]
+    return answers, (time.perf_counter() - start) / len(pairs)
+
+# Return the time taken per query to look up its start and finish points,
+# which is included in the time of each query.
+def time_lookups(netlist, pairs):
+    start = time.perf_counter()
+    for start_point, finish_point in pairs:
+        netlist.startpoint_exists(start_point)
+        netlist.endpoint_exists(finish_point)
+    return (time.perf_counter() - start) / len(pairs)
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('netlist', nargs='?',
+                        help='Netlist XML file to use instead of a generated design')
+    parser.add_argument('--registers', type=int, default=20000,
+                        help='Number of registers in the generated design')
+    parser.add_argument('--ports', type=int, default=200,
+                        help='Number of input and output ports in the generated design')
+    parser.add_argument('--fan-in', type=int, default=3,
+                        help='Number of operands of each gate in the generated design')
+    parser.add_argument('--queries', type=int, default=1000,
+                        help='Number of random queries')
+    parser.add_argument('--seed', type=int, default=1,
+                        help='Random seed')
+    args = parser.parse_args()
+    rng = random.Random(args.seed)
+    Options.get_instance().set_traversal_cache_size(0)
+    with tempfile.TemporaryDirectory() as temp_dir:
+        if args.netlist:
+            netlist = Netlist(args.netlist)
+        else:
+            source = os.path.join(temp_dir, 'bench.sv')
+            xml = os.path.join(temp_dir, 'bench.xml')
+            generate_design(source, args.registers, args.ports, args.fan_in, rng)
+            if RunVerilator(defs.INSTALL_PREFIX).run(source, xml) > 0:
+                raise RuntimeError('error compiling design')
+            netlist = Netlist(xml)
+        vertices = netlist.get_named_vertices('')
+        starts = [v.get_name() for v in vertices
+                  if v.get_direction() == 'INPUT' or v.get_ast_type() == 'DST_REG']
+        finishes = [v.get_name() for v in vertices
+                    if v.get_direction() == 'OUTPUT' or v.get_ast_type() == 'DST_REG']
+        pairs = [(rng.choice(starts), rng.choice(finishes)) for _ in range(args.queries)]
+        print('{} start points, {} finish points'.format(len(starts), len(finishes)))
+        lookup_time = time_lookups(netlist, pairs)
+        search_answers, search_time = time_queries(netlist, pairs)
+        start = time.perf_counter()
+        netlist.build_reachability_index()
+        build_time = time.perf_counter() - start
+        index = os.path.join(temp_dir, 'bench.idx')
+        netlist.save_reachability_index(index)
+        start = time.perf_counter()
+        netlist.load_reachability_index(index)
+        load_time = time.perf_counter() - start
+        index_answers, index_time = time_queries(netlist, pairs)
+        if index_answers != search_answers:
+            raise RuntimeError('index and search answers differ')
+        print('{} of {} queries have paths'.format(sum(search_answers), len(pairs)))
+        print('Index build {:.3f} s, load {:.3f} s, {} bytes'.format(
+              build_time, load_time, os.path.getsize(index)))
+        print('Name lookup {:.1f} us per query'.format(lookup_time * 1e6))
+        search_time = max(search_time - lookup_time, 0)
+        index_time = max(index_time - lookup_time, 0)
+        print('Search      {:.1f} us per query, excluding lookup'.format(search_time * 1e6))
+        print('Index       {:.1f} us per query, excluding lookup'.format(index_time * 1e6))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -1,13 +1,20 @@
+import json
 import os
 import subprocess
+import tempfile
+import time
 import unittest
 import definitions as defs
 
 NETLIST_PATHS=os.path.join(defs.INSTALL_PREFIX, 'netlist_paths.py')
+NETLIST_PATHS_NATIVE=os.path.join(defs.INSTALL_PREFIX, 'netlist-paths')
 
 def run(args):
     return subprocess.check_call([NETLIST_PATHS]+args)
 
+def run_output(args):
+    return subprocess.check_output([NETLIST_PATHS]+args).decode()
+
 class TestTool(unittest.TestCase):
 
     def setUp(self):
@@ -19,5 +26,100 @@ class TestTool(unittest.TestCase):
     def test_adder(self):
         self.assertEqual(run(['--compile', os.path.join(defs.TEST_SRC_PREFIX, 'adder.sv')]), 0)
 
+    def test_native(self):
+        self.assertTrue(os.path.exists(NETLIST_PATHS_NATIVE))
+        path = os.path.join(tempfile.mkdtemp(), 'adder.xml')
+        self.assertEqual(run(['--compile', os.path.join(defs.TEST_SRC_PREFIX, 'adder.sv'),
+                              '--output', path]), 0)
+        # The native tool gives the same reports.
+        for args in (['--dump-names'], ['--from', 'i_a', '--to', 'o_sum'],
+                     ['--from', 'i_a'], ['--fanin-degree'], ['--from', 'foo']):
+            native = subprocess.run([NETLIST_PATHS_NATIVE, path]+args, stdout=subprocess.PIPE)
+            script = subprocess.run([NETLIST_PATHS, path]+args, stdout=subprocess.PIPE)
+            self.assertEqual(native.stdout, script.stdout)
+            self.assertEqual(native.returncode, script.returncode)
+
+    def test_batch(self):
+        path = os.path.join(tempfile.mkdtemp(), 'queries.jsonl')
+        with open(path, 'w') as f:
+            f.write('{"query": "path_exists", "from": "i_a", "to": "o_sum"}\n')
+            f.write('{"query": "path_exists", "from": "o_sum", "to": "i_a"}\n')
+            f.write('{"id": "degree", "query": "fanin_degree", "to": "o_co"}\n')
+            # Constraints a query cannot apply are rejected.
+            f.write('{"query": "fanout_paths", "from": "i_a", "through": ["o_sum"]}\n')
+            f.write('{"query": "fanin_degree", "to": "o_co", "avoid": ["i_a"]}\n')
+        output = run_output(['--compile', '--batch', path, '-j', '2',
+                             os.path.join(defs.TEST_SRC_PREFIX, 'adder.sv')])
+        responses = [json.loads(line) for line in output.splitlines()]
+        self.assertEqual(responses, [{'id': 1, 'result': True},
+                                     {'id': 2, 'error': 'could not find start vertex o_sum'},
+                                     {'id': 'degree', 'result': 2},
+                                     {'id': 4, 'error': 'cannot specify through points with fanout paths'},
+                                     {'id': 5, 'error': 'cannot specify avoid points with fanin degree'}])
+
+    def test_reachability_index(self):
+        temp_dir = tempfile.mkdtemp()
+        path = os.path.join(temp_dir, 'adder.xml')
+        self.assertEqual(run(['--compile', os.path.join(defs.TEST_SRC_PREFIX, 'adder.sv'),
+                              '--output', path]), 0)
+        index = os.path.join(temp_dir, 'adder.idx')
+        args = [path, '--reachability-index', index, '--from', 'i_a', '--to', 'o_sum']
+        for tool in (NETLIST_PATHS, NETLIST_PATHS_NATIVE):
+            # A missing index is built and saved, then loaded.
+            self.assertEqual(subprocess.call([tool]+args), 0)
+            self.assertTrue(os.path.exists(index))
+            self.assertEqual(subprocess.call([tool]+args), 0)
+            # A corrupt index is reported rather than replaced.
+            with open(index, 'w') as f:
+                f.write('foo')
+            self.assertNotEqual(subprocess.call([tool]+args), 0)
+            with open(index) as f:
+                self.assertEqual(f.read(), 'foo')
+            # An index older than the netlist is rebuilt.
+            mtime = os.path.getmtime(path)
+            os.utime(index, (mtime - 1, mtime - 1))
+            self.assertEqual(subprocess.call([tool]+args), 0)
+            os.remove(index)
+
+    def test_server(self):
+        path = os.path.join(tempfile.mkdtemp(), 'netlist_paths.sock')
+        # A file that is not a socket is not replaced.
+        with open(path, 'w') as f:
+            f.write('foo')
+        self.assertNotEqual(subprocess.call([NETLIST_PATHS, '--compile', '--serve', path,
+                                             os.path.join(defs.TEST_SRC_PREFIX, 'adder.sv')]), 0)
+        with open(path) as f:
+            self.assertEqual(f.read(), 'foo')
+        os.remove(path)
+        server = subprocess.Popen([NETLIST_PATHS, '--compile', '--serve', path,
+                                   os.path.join(defs.TEST_SRC_PREFIX, 'adder.sv')])
+        try:
+            while not os.path.exists(path):
+                self.assertIsNone(server.poll())
+                time.sleep(0.1)
+            response = json.loads(run_output(['--connect', path]))
+            self.assertEqual(response['result'], ['adder'])
+            response = json.loads(run_output(['--connect', path, '--from', 'i_a', '--to', 'o_sum']))
+            self.assertEqual(response['result'][0]['name'], 'i_a')
+            self.assertEqual(response['result'][-1]['name'], 'o_sum')
+            response = json.loads(run_output(['--connect', path, '--from', 'i_a', '--fanout-degree']))
+            self.assertEqual(response['result'], 2)
+            # Constraints a query cannot apply are rejected by the server.
+            output = subprocess.run([NETLIST_PATHS, '--connect', path, '--from', 'i_a',
+                                     '--fanout-degree', '--avoid', 'o_sum'], stdout=subprocess.PIPE)
+            self.assertEqual(output.returncode, 1)
+            self.assertEqual(json.loads(output.stdout.decode())['error'],
+                             'cannot specify avoid points with fanout degree')
+            # Options the server does not answer are rejected by the client.
+            for args in (['--comb-loops'], ['--fanout-degree'], ['--from', 'i_a', '--to', 'o_sum', '--matrix']):
+                output = subprocess.run([NETLIST_PATHS, '--connect', path]+args, stdout=subprocess.PIPE)
+                self.assertEqual(output.returncode, 1)
+                self.assertTrue(output.stdout.decode().startswith('Error: cannot query a server'))
+            self.assertEqual(run(['--connect', path, '--shutdown']), 0)
+            self.assertEqual(server.wait(timeout=10), 0)
+        finally:
+            if server.poll() is None:
+                server.kill()
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,15 @@
+// A combinational loop between two variables.
+module comb_loop
+  (
+    input  logic i_a,
+    output logic o_b
+  );
+
+  logic x;
+  logic y;
+
+  assign x = i_a & y;
+  assign y = ~x;
+  assign o_b = y;
+
+endmodule
@@ -0,0 +1,11 @@
+module inout_port
+  (
+    inout  logic io,
+    input  logic i_a,
+    output logic o_b
+  );
+
+  assign io = i_a;
+  assign o_b = io;
+
+endmodule
@@ -0,0 +1,572 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include "netlist_paths/Exception.hpp"
+#include "netlist_paths/Netlist.hpp"
+#include "netlist_paths/Options.hpp"
+#include "netlist_paths/RunVerilator.hpp"
+#include "netlist_paths/Waypoints.hpp"
+
+namespace po = boost::program_options;
+
+using namespace netlist_paths;
+
+constexpr const char *DEFAULT_DOT_FILE = "graph.dot";
+
+/// Write a value left-aligned in a column of at least width characters.
+static void writeColumn(std::ostream &os, const std::string &value,
+                        std::size_t width) {
+  os << value;
+  for (auto i = value.size(); i < width; ++i) {
+    os.put(' ');
+  }
+}
+
+/// Dump a table of names and their attributes matching regex.
+static void dumpNames(const Netlist &netlist, const std::string &regex,
+                      std::ostream &os) {
+  using Row = std::array<std::string, 5>;
+  const Row header = {"Name", "Type", "DType", "Direction", "Location"};
+  std::vector<Row> rows;
+  // The vertices are returned in name order.
+  for (const Vertex &vertex : netlist.getNamedVertices(regex)) {
+    rows.push_back({vertex.getName(),
+                    vertex.getAstTypeStr(),
+                    vertex.getDTypeStr(),
+                    vertex.getDirStr(),
+                    vertex.getLocStr()});
+  }
+  // Calculate max widths for each column.
+  std::array<std::size_t, 5> widths;
+  for (std::size_t i = 0; i < header.size(); ++i) {
+    widths[i] = header[i].size();
+  }
+  for (auto &row : rows) {
+    for (std::size_t i = 0; i < row.size(); ++i) {
+      widths[i] = std::max(widths[i], row[i].size());
+    }
+  }
+  auto writeRow = [&](const Row &row) {
+    for (std::size_t i = 0; i < row.size(); ++i) {
+      writeColumn(os, row[i], widths[i]);
+      os.put(i + 1 < row.size() ? ' ' : '\n');
+    }
+  };
+  writeRow(header);
+  for (auto &row : rows) {
+    writeRow(row);
+  }
+}
+
+/// Report the details of a vertex on a path.
+static void dumpPathVertex(const Vertex &vertex, std::ostream &os) {
+  writeColumn(os, vertex.getAstTypeStr(), 16);
+  os.put(' ');
+  writeColumn(os, vertex.getDTypeStr(), 16);
+  os.put(' ');
+  writeColumn(os, std::to_string(vertex.getDTypeWidth()), 16);
+  os.put(' ');
+  writeColumn(os, vertex.getName(), 16);
+  os.put('\n');
+}
+
+/// Report the details of a path.
+static void dumpPathReport(const std::vector<Vertex*> &path, std::ostream &os) {
+  for (auto vertex : path) {
+    dumpPathVertex(*vertex, os);
+  }
+}
+
+/// Report each path produced by an enumerator, as it is produced.
+static void dumpPathListReport(const Netlist &netlist,
+                               PathEnumerator &enumerator,
+                               std::ostream &os) {
+  VertexIDVec path;
+  for (std::size_t i = 0; enumerator.next(path); ++i) {
+    os << "Path " << i << "\n";
+    for (auto vertex : path) {
+      dumpPathVertex(*netlist.getVertex(vertex), os);
+    }
+  }
+}
+
+/// Report a list of registers and ports.
+static void dumpRegisterReport(const std::vector<Vertex*> &vertices,
+                               std::ostream &os) {
+  for (auto vertex : vertices) {
+    writeColumn(os, vertex->getAstTypeStr(), 16);
+    os.put(' ');
+    writeColumn(os, vertex->getDTypeStr(), 16);
+    os << ' ' << vertex->getName() << "\n";
+  }
+}
+
+/// Report a count (such as a degree or depth) for each point, ordered by
+/// decreasing count or by name.
+static void dumpCountReport(std::vector<std::pair<Vertex*, std::size_t>> counts,
+                            const std::string &title,
+                            const std::string &sortKey,
+                            std::ostream &os) {
+  if (sortKey == "name") {
+    std::sort(std::begin(counts), std::end(counts),
+              [](const std::pair<Vertex*, std::size_t> &a,
+                 const std::pair<Vertex*, std::size_t> &b) {
+                auto order = a.first->getName().compare(b.first->getName());
+                return order != 0 ? order < 0 : a.second < b.second; });
+  } else {
+    std::sort(std::begin(counts), std::end(counts),
+              [](const std::pair<Vertex*, std::size_t> &a,
+                 const std::pair<Vertex*, std::size_t> &b) {
+                if (a.second != b.second) {
+                  return a.second > b.second;
+                }
+                return a.first->getName() < b.first->getName(); });
+  }
+  writeColumn(os, title, 10);
+  os.put(' ');
+  writeColumn(os, "Type", 16);
+  os << " Name\n";
+  for (auto &count : counts) {
+    writeColumn(os, std::to_string(count.second), 10);
+    os.put(' ');
+    writeColumn(os, count.first->getAstTypeStr(), 16);
+    os << ' ' << count.first->getName() << "\n";
+  }
+}
+
+/// Report the k paths with the largest logic depths.
+static void dumpDeepestPathsReport(const Netlist &netlist, std::size_t k,
+                                   std::ostream &os) {
+  auto paths = netlist.getDeepestPaths(k);
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    auto depth = std::count_if(std::begin(paths[i]), std::end(paths[i]),
+                               [](Vertex *vertex) { return vertex->isLogic(); });
+    os << "Path " << i << " (depth " << depth << ")\n";
+    dumpPathReport(paths[i], os);
+  }
+}
+
+/// Report a histogram of the logic depths of all finish points, and their
+/// maximum and mean depths in each module instance.
+static void dumpDepthStatsReport(const Netlist &netlist, std::ostream &os) {
+  auto histogram = netlist.getLogicDepthHistogram();
+  writeColumn(os, "Depth", 10);
+  os << " Count\n";
+  for (std::size_t depth = 0; depth < histogram.size(); ++depth) {
+    writeColumn(os, std::to_string(depth), 10);
+    os << ' ' << histogram[depth] << "\n";
+  }
+  auto stats = netlist.getLogicDepthModuleStats();
+  std::size_t width = std::string("Module").size();
+  for (auto &module : stats) {
+    width = std::max(width, module.name.size());
+  }
+  writeColumn(os, "Module", width);
+  os.put(' ');
+  writeColumn(os, "Count", 10);
+  os.put(' ');
+  writeColumn(os, "Max", 10);
+  os << " Mean\n";
+  for (auto &module : stats) {
+    char mean[32];
+    std::snprintf(mean, sizeof(mean), "%.2f",
+                  static_cast<double>(module.totalDepth) / module.numFinishPoints);
+    writeColumn(os, module.name.empty() ? "<top>" : module.name, width);
+    os.put(' ');
+    writeColumn(os, std::to_string(module.numFinishPoints), 10);
+    os.put(' ');
+    writeColumn(os, std::to_string(module.maxDepth), 10);
+    os << ' ' << mean << "\n";
+  }
+}
+
+/// Report the variables and logic of each combinational loop.
+static void dumpCombLoopsReport(const Netlist &netlist, std::ostream &os) {
+  auto loops = netlist.getCombLoops();
+  for (std::size_t i = 0; i < loops.size(); ++i) {
+    os << "Loop " << i << "\n";
+    for (auto vertex : loops[i]) {
+      os << "  ";
+      writeColumn(os, vertex->getAstTypeStr(), 16);
+      os.put(' ');
+      writeColumn(os, vertex->getName(), 32);
+      os << ' ' << vertex->getLocStr() << "\n";
+    }
+  }
+  os << loops.size() << " combinational loops\n";
+}
+
+/// Read pairs of start and finish points from a file, one pair per line, and
+/// report whether a path exists between each of them.
+static void dumpPathsExistReport(const Netlist &netlist,
+                                 const std::string &filename,
+                                 std::ostream &os) {
+  std::ifstream file(filename);
+  if (!file) {
+    throw Exception("could not open file "+filename);
+  }
+  std::vector<std::pair<std::string, std::string>> points;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream ss(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (ss >> token) {
+      tokens.push_back(token);
+    }
+    if (tokens.empty() || tokens[0][0] == '#') {
+      continue;
+    }
+    if (tokens.size() != 2) {
+      auto begin = line.find_first_not_of(" \t\r");
+      auto end = line.find_last_not_of(" \t\r");
+      throw Exception("expected a start and finish point: "+
+                      line.substr(begin, end - begin + 1));
+    }
+    points.emplace_back(tokens[0], tokens[1]);
+  }
+  std::vector<Waypoints> waypoints;
+  for (auto &point : points) {
+    waypoints.emplace_back(point.first, point.second);
+  }
+  auto results = netlist.pathsExist(waypoints);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    os << points[i].first << ' ' << points[i].second << ' '
+       << (results[i] ? "yes" : "no") << "\n";
+  }
+}
+
+/// Report which of the start points matching a pattern have paths to each of
+/// the finish points matching another, not passing through any avoid points,
+/// optionally with an example of each path.
+static void dumpPathMatrixReport(const Netlist &netlist,
+                                 const std::string &start,
+                                 const std::string &finish,
+                                 bool withPaths,
+                                 const std::vector<std::string> &avoidPoints,
+                                 std::ostream &os) {
+  auto matrix = netlist.getPathMatrix(start, finish, withPaths, avoidPoints);
+  auto &starts = matrix.startPoints;
+  auto &finishes = matrix.finishPoints;
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < starts.size(); ++i) {
+    for (std::size_t j = 0; j < finishes.size(); ++j) {
+      if (matrix.connected[i][j]) {
+        os << starts[i]->getName() << ' ' << finishes[j]->getName() << "\n";
+        if (withPaths) {
+          dumpPathReport(matrix.paths[i][j], os);
+        }
+        count++;
+      }
+    }
+  }
+  os << count << " of " << starts.size() * finishes.size()
+     << " pairs connected (" << starts.size() << " start points, "
+     << finishes.size() << " finish points)\n";
+}
+
+/// Load a reachability index from a file or, if the file does not exist or is
+/// older than the netlist's input file, build the index and save it to the
+/// file. Any other failure to load the index is reported.
+static void loadReachabilityIndex(Netlist &netlist, const std::string &filename,
+                                  const std::string &inputFilename) {
+  if (boost::filesystem::exists(filename) &&
+      boost::filesystem::last_write_time(filename) >=
+        boost::filesystem::last_write_time(inputFilename)) {
+    netlist.loadReachabilityIndex(filename);
+  } else {
+    netlist.buildReachabilityIndex();
+    netlist.saveReachabilityIndex(filename);
+  }
+}
+
+static int run(const po::variables_map &vm, std::ostream &os) {
+  auto files = vm["files"].as<std::vector<std::string>>();
+  auto outputFile = vm.count("output") ? vm["output"].as<std::string>() : "";
+  auto startPoint = vm.count("from") ? vm["from"].as<std::string>() : "";
+  auto finishPoint = vm.count("to") ? vm["to"].as<std::string>() : "";
+  auto throughPoints = vm["though"].as<std::vector<std::string>>();
+  auto avoidPoints = vm["avoid"].as<std::vector<std::string>>();
+  auto conePoints = vm["cone"].as<std::vector<std::string>>();
+  auto coneDirection = vm["cone-direction"].as<std::string>();
+  auto sortKey = vm["sort"].as<std::string>();
+  auto dumpNamesRegex = vm.count("dump-names") ? vm["dump-names"].as<std::string>() : "";
+  bool compile = vm.count("compile");
+  // Verilator compilation (only support one source file).
+  std::string tempName;
+  if (compile) {
+    RunVerilator runVerilator;
+    tempName = boost::filesystem::unique_path().native();
+    if (runVerilator.run(vm["include"].as<std::vector<std::string>>(),
+                         vm["define"].as<std::vector<std::string>>(),
+                         {files[0]}, tempName) > 0) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(tempName, ec);
+      throw Exception("error compiling design");
+    }
+  }
+  // Create the netlist, not leaving a compiled XML behind if it is invalid.
+  std::unique_ptr<Netlist> netlist;
+  try {
+    netlist = std::make_unique<Netlist>(compile ? tempName : files[0]);
+  } catch (...) {
+    if (compile) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(tempName, ec);
+    }
+    throw;
+  }
+  // If compiling and no further steps are performed and an output file is
+  // specified, rename the XML to the output, otherwise delete it.
+  if (compile) {
+    bool query = vm.count("dump-names") || vm.count("dump-dot") ||
+                 vm.count("comb-loops") || vm.count("fanout-degree") ||
+                 vm.count("fanin-degree") || vm.count("logic-depths") ||
+                 vm.count("depth-stats") || vm.count("deepest-paths") ||
+                 vm.count("paths-exist") ||
+                 !startPoint.empty() || !finishPoint.empty();
+    if (!outputFile.empty() && !query) {
+      boost::filesystem::rename(tempName, outputFile);
+    } else {
+      boost::filesystem::remove(tempName);
+    }
+  }
+  // Cone of influence.
+  if (!conePoints.empty()) {
+    netlist = netlist->extractCone(conePoints,
+                                   coneDirection == "fanin" || coneDirection == "both",
+                                   coneDirection == "fanout" || coneDirection == "both");
+  }
+  // Reachability index.
+  if (vm.count("reachability-index")) {
+    loadReachabilityIndex(*netlist, vm["reachability-index"].as<std::string>(),
+                          files[0]);
+  }
+  // Dump names.
+  if (!dumpNamesRegex.empty()) {
+    dumpNames(*netlist, dumpNamesRegex, os);
+    return 0;
+  }
+  if (vm.count("dump-dot")) {
+    netlist->dumpDotFile(outputFile.empty() ? DEFAULT_DOT_FILE : outputFile);
+    return 0;
+  }
+  // Combinational loops.
+  if (vm.count("comb-loops")) {
+    dumpCombLoopsReport(*netlist, os);
+    return 0;
+  }
+  // Fan out and fan in degrees.
+  if (vm.count("fanout-degree")) {
+    if (!startPoint.empty()) {
+      os << netlist->getFanOutDegree(startPoint) << "\n";
+    } else {
+      dumpCountReport(netlist->getAllFanOutDegrees(), "Degree", sortKey, os);
+    }
+    return 0;
+  }
+  if (vm.count("fanin-degree")) {
+    if (!finishPoint.empty()) {
+      os << netlist->getFanInDegree(finishPoint) << "\n";
+    } else {
+      dumpCountReport(netlist->getAllFanInDegrees(), "Degree", sortKey, os);
+    }
+    return 0;
+  }
+  // Logic depths.
+  if (vm.count("logic-depths")) {
+    if (!finishPoint.empty()) {
+      os << netlist->getLogicDepth(finishPoint) << "\n";
+    } else {
+      dumpCountReport(netlist->getAllLogicDepths(), "Depth", sortKey, os);
+    }
+    return 0;
+  }
+  if (vm.count("depth-stats")) {
+    dumpDepthStatsReport(*netlist, os);
+    return 0;
+  }
+  if (vm.count("deepest-paths")) {
+    dumpDeepestPathsReport(*netlist, vm["deepest-paths"].as<std::size_t>(), os);
+    return 0;
+  }
+  // Batched path existence.
+  if (vm.count("paths-exist")) {
+    dumpPathsExistReport(*netlist, vm["paths-exist"].as<std::string>(), os);
+    return 0;
+  }
+  // Connectivity matrix.
+  if (vm.count("matrix") || vm.count("matrix-paths")) {
+    if (startPoint.empty() || finishPoint.empty()) {
+      throw Exception("a matrix query requires a start and finish point");
+    }
+    if (!throughPoints.empty()) {
+      throw Exception("cannot specify through points with a matrix query");
+    }
+    dumpPathMatrixReport(*netlist, startPoint, finishPoint,
+                         vm.count("matrix-paths"), avoidPoints, os);
+    return 0;
+  }
+  // Point-to-point path.
+  if (!startPoint.empty() && !finishPoint.empty()) {
+    Waypoints waypoints;
+    waypoints.addStartPoint(startPoint);
+    waypoints.addFinishPoint(finishPoint);
+    for (auto &point : throughPoints) {
+      waypoints.addThroughPoint(point);
+    }
+    for (auto &point : avoidPoints) {
+      waypoints.addAvoidPoint(point);
+    }
+    if (vm.count("all-paths")) {
+      dumpPathListReport(*netlist, *netlist->getAllPathsEnumerator(waypoints), os);
+    } else {
+      dumpPathReport(netlist->getAnyPath(waypoints), os);
+    }
+    return 0;
+  }
+  // Fan out paths.
+  if (!startPoint.empty()) {
+    if (!throughPoints.empty()) {
+      throw Exception("cannot specify through points with fanout paths");
+    }
+    if (vm.count("registers")) {
+      if (!avoidPoints.empty()) {
+        throw Exception("cannot specify avoid points with register fanout");
+      }
+      dumpRegisterReport(netlist->getRegisterFanOut(startPoint), os);
+      return 0;
+    }
+    dumpPathListReport(*netlist, *netlist->getAllFanOutEnumerator(startPoint, avoidPoints), os);
+    return 0;
+  }
+  // Fan in paths.
+  if (!finishPoint.empty()) {
+    if (!throughPoints.empty()) {
+      throw Exception("cannot specify through points with fanin paths");
+    }
+    if (vm.count("registers")) {
+      if (!avoidPoints.empty()) {
+        throw Exception("cannot specify avoid points with register fanin");
+      }
+      dumpRegisterReport(netlist->getRegisterFanIn(finishPoint), os);
+      return 0;
+    }
+    dumpPathListReport(*netlist, *netlist->getAllFanInEnumerator(finishPoint, avoidPoints), os);
+    return 0;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  po::options_description options("Options");
+  options.add_options()
+    ("help,h", "Display help")
+    ("compile,c", "Run Verilator to compile a netlist")
+    ("include,I", po::value<std::vector<std::string>>()->composing()->default_value(std::vector<std::string>(), ""),
+                  "Add a source include path (only with --compile)")
+    ("define,D", po::value<std::vector<std::string>>()->composing()->default_value(std::vector<std::string>(), ""),
+                 "Define a preprocessor macro (only with --compile)")
+    ("output,o", po::value<std::string>(), "Specify an output file")
+    ("dump-names", po::value<std::string>()->implicit_value(".*"),
+                   "Dump all names, filter by regex")
+    ("dump-dot", "Dump a dotfile of the netlist's graph")
+    ("comb-loops", "Report all combinational loops")
+    ("fanout-degree", "Report the number of finish points reachable from the start point, or from every start point")
+    ("fanin-degree", "Report the number of start points reaching the finish point, or every finish point")
+    ("logic-depths", "Report the logic depth of the finish point, or of every finish point")
+    ("depth-stats", "Report a histogram of finish point logic depths and per-module depth statistics")
+    ("deepest-paths", po::value<std::size_t>(), "Report the K paths with the largest logic depths")
+    ("sort", po::value<std::string>()->default_value("degree"),
+             "Order of the degree and depth reports: degree or name")
+    ("cone", po::value<std::vector<std::string>>()->composing()->default_value(std::vector<std::string>(), ""),
+             "Restrict the netlist to the cone of a point before other queries")
+    ("cone-direction", po::value<std::string>()->default_value("fanin"),
+                       "Direction of the cones of --cone points: fanin, fanout or both")
+    ("from", po::value<std::string>(), "Start point")
+    ("to", po::value<std::string>(), "Finish point")
+    ("though", po::value<std::vector<std::string>>()->composing()->default_value(std::vector<std::string>(), ""),
+               "Though point")
+    ("avoid", po::value<std::vector<std::string>>()->composing()->default_value(std::vector<std::string>(), ""),
+              "Avoid point (a name or pattern)")
+    ("matrix", "Report the connectivity of every start point matching --from to every finish point matching --to")
+    ("matrix-paths", "Report an example path for each connected pair of a --matrix query")
+    ("paths-exist", po::value<std::string>(),
+                    "Report whether paths exist between each pair of start and finish points in a file")
+    ("reachability-index", po::value<std::string>(),
+                           "Answer path existence queries with a reachability index, loaded from file, or built and saved to it if the file is missing or older than the input file")
+    ("all-paths", "Find all paths between two points (exponential time)")
+    ("registers", "Report the registers and ports fanning out or in, rather than paths")
+    ("regex", "Enable regular expression matching of names")
+    ("threads,j", po::value<unsigned>()->default_value(0),
+                  "Number of threads to use (default: all cores)")
+    ("verbose,v", "Print execution information")
+    ("debug,d", "Print debugging information");
+  po::options_description hidden;
+  hidden.add_options()
+    ("files", po::value<std::vector<std::string>>()->default_value(std::vector<std::string>(), ""),
+              "Input files");
+  po::options_description all;
+  all.add(options).add(hidden);
+  po::positional_options_description positional;
+  positional.add("files", -1);
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv)
+                  .options(all).positional(positional).run(), vm);
+    po::notify(vm);
+    if (vm.count("sort") && vm["sort"].as<std::string>() != "degree" &&
+        vm["sort"].as<std::string>() != "name") {
+      throw po::validation_error(po::validation_error::invalid_option_value, "sort");
+    }
+    auto &direction = vm["cone-direction"].as<std::string>();
+    if (direction != "fanin" && direction != "fanout" && direction != "both") {
+      throw po::validation_error(po::validation_error::invalid_option_value, "cone-direction");
+    }
+  } catch (const po::error &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
+  }
+  if (vm.count("help") || vm["files"].as<std::vector<std::string>>().empty()) {
+    std::cout << "Query a Verilog netlist\n\n"
+              << "Usage: " << argv[0] << " [options] files...\n\n"
+              << options;
+    return vm.count("help") ? 0 : 1;
+  }
+  // Setup options.
+  if (vm.count("regex")) {
+    Options::getInstance().setMatchRegex();
+  }
+  if (vm.count("verbose")) {
+    Options::getInstance().setVerbose();
+  }
+  if (vm.count("debug")) {
+    Options::getInstance().setDebug();
+  }
+  Options::getInstance().setNumThreads(vm["threads"].as<unsigned>());
+  // Reports are written through a large buffer, flushed on exit.
+  std::ios::sync_with_stdio(false);
+  static char buffer[1 << 16];
+  std::cout.rdbuf()->pubsetbuf(buffer, sizeof(buffer));
+  try {
+    auto result = run(vm, std::cout);
+    std::cout.flush();
+    return result;
+  } catch (const Exception &e) {
+    std::cout << "Error: " << e.what() << "\n";
+    std::cout.flush();
+    return 1;
+  } catch (const std::exception &e) {
+    // Errors from Boost, such as failing to run Verilator or to rename files.
+    std::cout << "Error: " << e.what() << "\n";
+    std::cout.flush();
+    return 1;
+  }
+}
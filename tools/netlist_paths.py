@@ -1,12 +1,18 @@
 #!/usr/bin/env python3
 
 import argparse
+import json
 import sys
 import os
+import socket
+import socketserver
+import stat
 import tempfile
+import threading
+from concurrent.futures import ThreadPoolExecutor
 import definitions as defs
 sys.path.insert(0, os.path.join(defs.BINARY_DIR_PREFIX, 'lib', 'netlist_paths'))
-from py_netlist_paths import RunVerilator, Netlist, Waypoints, Options
+from py_netlist_paths import RunVerilator, Netlist, Waypoints, Options, QueryContext
 
 
 DEFAULT_DOT_FILE = 'graph.dot'
@@ -15,11 +21,8 @@ DEFAULT_DOT_FILE = 'graph.dot'
 def dump_names(netlist, regex, fd):
     rows = []
     HDR = ['Name', 'Type', 'DType', 'Direction', 'Location']
+    # The vertices are returned in name order.
     vertices = netlist.get_named_vertices(regex)
-    vertices = sorted(vertices, key=lambda x: (x.get_name(),
-                                               x.get_ast_type(),
-                                               x.get_dtype_str(),
-                                               x.get_direction()))
     for vertex in vertices:
         rows.append((vertex.get_name(),
                      vertex.get_ast_type(),
@@ -51,10 +54,403 @@ def dump_path_list_report(netlist, paths, fd):
         print('Path {}'.format(i))
         dump_path_report(netlist, path, fd)
 
+# Report a list of registers and ports.
+def dump_register_report(netlist, vertices, fd):
+    for vertex in vertices:
+        fd.write('{:<16} {:<16} {}\n'.format(vertex.get_ast_type(),
+                                             vertex.get_dtype_str(),
+                                             vertex.get_name()))
+
+# Report a count (such as a degree or depth) for each point, ordered by
+# decreasing count or by name.
+def dump_count_report(netlist, counts, title, sort_key, fd):
+    if sort_key == 'name':
+        counts = sorted(counts, key=lambda x: (x[0].get_name(), x[1]))
+    else:
+        counts = sorted(counts, key=lambda x: (-x[1], x[0].get_name()))
+    fd.write('{:<10} {:<16} {}\n'.format(title, 'Type', 'Name'))
+    for vertex, count in counts:
+        fd.write('{:<10} {:<16} {}\n'.format(count,
+                                             vertex.get_ast_type(),
+                                             vertex.get_name()))
+
+# Report the k paths with the largest logic depths.
+def dump_deepest_paths_report(netlist, k, fd):
+    for i, path in enumerate(netlist.get_deepest_paths(k)):
+        depth = len([vertex for vertex in path if vertex.is_logic()])
+        fd.write('Path {} (depth {})\n'.format(i, depth))
+        dump_path_report(netlist, path, fd)
+
+# Report a histogram of the logic depths of all finish points, and their
+# maximum and mean depths in each module instance.
+def dump_depth_stats_report(netlist, fd):
+    histogram = netlist.get_logic_depth_histogram()
+    fd.write('{:<10} {}\n'.format('Depth', 'Count'))
+    for depth, count in enumerate(histogram):
+        fd.write('{:<10} {}\n'.format(depth, count))
+    stats = netlist.get_module_depth_stats()
+    width = max([len('Module')] + [len(module) for module, _, _, _ in stats])
+    fd.write('{:<{w}} {:<10} {:<10} {}\n'.format('Module', 'Count', 'Max', 'Mean', w=width))
+    for module, count, max_depth, mean_depth in stats:
+        fd.write('{:<{w}} {:<10} {:<10} {:.2f}\n'.format(module if module else '<top>',
+                                                       count, max_depth, mean_depth, w=width))
+
+# Report the variables and logic of each combinational loop.
+def dump_comb_loops_report(netlist, fd):
+    loops = netlist.get_comb_loops()
+    for i, loop in enumerate(loops):
+        fd.write('Loop {}\n'.format(i))
+        for vertex in loop:
+            fd.write('  {:<16} {:<32} {}\n'.format(vertex.get_ast_type(),
+                                                   vertex.get_name(),
+                                                   vertex.get_location()))
+    fd.write('{} combinational loops\n'.format(len(loops)))
+
+# Read pairs of start and finish points from a file, one pair per line, and
+# report whether a path exists between each of them.
+def dump_paths_exist_report(netlist, filename, fd):
+    points = []
+    with open(filename) as f:
+        for line in f:
+            tokens = line.split()
+            if len(tokens) == 0 or tokens[0].startswith('#'):
+                continue
+            if len(tokens) != 2:
+                raise RuntimeError('expected a start and finish point: '+line.strip())
+            points.append(tokens)
+    results = netlist.paths_exist([Waypoints(start, finish) for start, finish in points])
+    for (start, finish), exists in zip(points, results):
+        fd.write('{} {} {}\n'.format(start, finish, 'yes' if exists else 'no'))
+
+# Report which of the start points matching a pattern have paths to each of
+# the finish points matching another, not passing through any avoid points,
+# optionally with an example of each path.
+def dump_path_matrix_report(netlist, start, finish, with_paths, avoid, fd):
+    starts, finishes, connected, paths = \
+        netlist.get_path_matrix(start, finish, with_paths, avoid)
+    count = 0
+    for i, start_vertex in enumerate(starts):
+        for j, finish_vertex in enumerate(finishes):
+            if connected[i][j]:
+                fd.write('{} {}\n'.format(start_vertex.get_name(),
+                                          finish_vertex.get_name()))
+                if with_paths:
+                    dump_path_report(netlist, paths[i][j], fd)
+                count += 1
+    fd.write('{} of {} pairs connected ({} start points, {} finish points)\n'
+             .format(count, len(starts) * len(finishes), len(starts), len(finishes)))
+
+# Create waypoints from a start and finish point, and lists of through and
+# avoid points.
+def create_waypoints(start, finish, through=[], avoid=[]):
+    waypoints = Waypoints()
+    waypoints.add_start_point(start)
+    waypoints.add_finish_point(finish)
+    [waypoints.add_through_point(point) for point in through]
+    [waypoints.add_avoid_point(point) for point in avoid]
+    return waypoints
+
+# Convert a vertex to a JSON object.
+def vertex_to_json(vertex):
+    return {'name': vertex.get_name(),
+            'type': vertex.get_ast_type(),
+            'dtype': vertex.get_dtype_str(),
+            'width': vertex.get_dtype_width()}
+
+def path_to_json(path):
+    return [vertex_to_json(vertex) for vertex in path]
+
+# The lists of points, besides the start and finish points, each kind of
+# query accepts.
+QUERY_CONSTRAINTS = {'path_exists':     ('through', 'avoid'),
+                     'any_path':        ('through', 'avoid'),
+                     'all_paths':       ('through', 'avoid'),
+                     'fanout_paths':    ('avoid',),
+                     'fanin_paths':     ('avoid',),
+                     'fanout_degree':   (),
+                     'fanin_degree':    (),
+                     'register_fanout': (),
+                     'register_fanin':  (),
+                     'logic_depth':     (),
+                     'names':           ()}
+
+# Answer a query, given as a JSON object, against a netlist, returning a JSON
+# result. A query has a 'query' kind, 'from' and 'to' points, and lists of
+# 'through' and 'avoid' points, as the command-line options. Through and
+# avoid points are rejected by the queries that cannot apply them.
+def answer_query(netlist, query):
+    kind = query.get('query')
+    start = query.get('from')
+    finish = query.get('to')
+    if kind in QUERY_CONSTRAINTS:
+        for constraint in ('through', 'avoid'):
+            if query.get(constraint) and constraint not in QUERY_CONSTRAINTS[kind]:
+                raise RuntimeError('cannot specify {} points with {}'
+                                   .format(constraint, kind.replace('_', ' ')))
+    def waypoints():
+        if not (start and finish):
+            raise RuntimeError('query {} requires a start and finish point'.format(kind))
+        return create_waypoints(start, finish,
+                                query.get('through', []), query.get('avoid', []))
+    if kind == 'path_exists':
+        return netlist.path_exists(waypoints())
+    if kind == 'any_path':
+        return path_to_json(netlist.get_any_path(waypoints()))
+    if kind == 'all_paths':
+        return [path_to_json(path) for path in netlist.iter_all_paths(waypoints())]
+    if kind == 'fanout_paths':
+        return [path_to_json(path) for path in netlist.iter_all_fanout_paths(start, query.get('avoid', []))]
+    if kind == 'fanin_paths':
+        return [path_to_json(path) for path in netlist.iter_all_fanin_paths(finish, query.get('avoid', []))]
+    if kind == 'fanout_degree':
+        return netlist.get_fanout_degree(start)
+    if kind == 'fanin_degree':
+        return netlist.get_fanin_degree(finish)
+    if kind == 'register_fanout':
+        return [vertex_to_json(vertex) for vertex in netlist.get_register_fanout(start)]
+    if kind == 'register_fanin':
+        return [vertex_to_json(vertex) for vertex in netlist.get_register_fanin(finish)]
+    if kind == 'logic_depth':
+        return netlist.get_logic_depth(finish)
+    if kind == 'names':
+        return [vertex.get_name() for vertex in netlist.get_named_vertices(query.get('pattern', ''))]
+    raise RuntimeError('unknown query: {}'.format(kind))
+
+# The query context of each thread answering requests, reused by its requests
+# so that they also reuse its traversal buffers, and the name matching mode it
+# was created with.
+worker_contexts = threading.local()
+
+def get_worker_context():
+    if not hasattr(worker_contexts, 'context'):
+        worker_contexts.context = QueryContext()
+        worker_contexts.match_wildcard = worker_contexts.context.get_match_wildcard()
+    return worker_contexts.context
+
+# Answer a request, given as a line of JSON, against one of a dictionary of
+# named netlists, returning a JSON response. The request's 'id' is copied to
+# the response, which has either a 'result' or an 'error'. A 'regex' field
+# selects the name matching mode for this request only. If query_threads is
+# given, it limits the threads used by the query, such as when requests are
+# already answered in parallel.
+def answer_request(netlists, line, query_threads=None):
+    response = {}
+    try:
+        request = json.loads(line)
+        if not isinstance(request, dict):
+            raise RuntimeError('expected a JSON object')
+        response['id'] = request.get('id')
+        if request.get('query') == 'netlists':
+            response['result'] = sorted(netlists.keys())
+            return response
+        name = request.get('netlist')
+        if name is None:
+            if len(netlists) != 1:
+                raise RuntimeError('a netlist must be specified')
+            name = next(iter(netlists))
+        if name not in netlists:
+            raise RuntimeError('unknown netlist: {}'.format(name))
+        context = get_worker_context()
+        match_wildcard = worker_contexts.match_wildcard
+        if 'regex' in request:
+            match_wildcard = not request['regex']
+        if match_wildcard:
+            context.set_match_wildcard()
+        else:
+            context.set_match_regex()
+        if query_threads is not None:
+            context.set_num_threads(query_threads)
+        with context:
+            response['result'] = answer_query(netlists[name], request)
+    except Exception as e:
+        response['error'] = str(e)
+    return response
+
+# Answer the requests in a file, one JSON object per line as for a server,
+# against one netlist, writing a JSON response for each, in the same order.
+# Requests without an id are given their line number. The requests are
+# answered in parallel by num_threads workers, each query using one thread if
+# there are several workers.
+def dump_batch_report(netlist, name, filename, num_threads, fd):
+    lines = []
+    with open(filename) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if len(line) == 0 or line.startswith('#'):
+                continue
+            try:
+                request = json.loads(line)
+                if isinstance(request, dict) and 'id' not in request:
+                    request['id'] = number
+                    line = json.dumps(request)
+            except ValueError:
+                pass
+            lines.append(line)
+    netlists = {name: netlist}
+    query_threads = 1 if num_threads > 1 else None
+    with ThreadPoolExecutor(num_threads) as executor:
+        for response in executor.map(lambda line: answer_request(netlists, line, query_threads), lines):
+            fd.write(json.dumps(response)+'\n')
+
+# A shutdown request stops the server once the requests before it have been
+# answered.
+def is_shutdown_request(line):
+    try:
+        request = json.loads(line)
+    except ValueError:
+        return False
+    return isinstance(request, dict) and request.get('query') == 'shutdown'
+
+# Serve line-delimited JSON requests on a Unix domain socket. Each connection
+# is read by its own thread and its requests are answered by a shared pool of
+# workers, so responses can be returned out of order; they are matched to
+# requests by id. The netlist queries release the GIL, so the workers run
+# concurrently, each query using one thread if there are several workers.
+class QueryServer(socketserver.ThreadingMixIn, socketserver.UnixStreamServer):
+    daemon_threads = True
+
+    def __init__(self, path, netlists, num_workers):
+        self.netlists = netlists
+        self.query_threads = 1 if num_workers > 1 else None
+        self.executor = ThreadPoolExecutor(num_workers)
+        socketserver.UnixStreamServer.__init__(self, path, QueryHandler)
+
+class QueryHandler(socketserver.StreamRequestHandler):
+
+    def handle(self):
+        lock = threading.Lock()
+        def respond(line):
+            response = answer_request(self.server.netlists, line,
+                                      self.server.query_threads)
+            data = (json.dumps(response)+'\n').encode()
+            with lock:
+                try:
+                    self.wfile.write(data)
+                    self.wfile.flush()
+                except OSError:
+                    pass
+        futures = []
+        for line in self.rfile:
+            line = line.decode().strip()
+            if not line:
+                continue
+            if is_shutdown_request(line):
+                threading.Thread(target=self.server.shutdown).start()
+                break
+            futures.append(self.server.executor.submit(respond, line))
+        # Wait for the responses before the connection is closed.
+        for future in futures:
+            future.exception()
+
+# Load each netlist once and serve queries on a socket until a shutdown
+# request is received. A socket left by a previous server is replaced, but no
+# other kind of file is.
+def serve(netlists, path, num_workers):
+    if os.path.lexists(path):
+        if not stat.S_ISSOCK(os.lstat(path).st_mode):
+            raise RuntimeError('{} exists and is not a socket'.format(path))
+        os.remove(path)
+    with QueryServer(path, netlists, num_workers) as server:
+        print('Serving {} on {}'.format(', '.join(sorted(netlists.keys())), path),
+              file=sys.stderr)
+        try:
+            server.serve_forever()
+        finally:
+            server.executor.shutdown()
+            os.remove(path)
+    return 0
+
+# Send a request to a server and return its response, or None for a shutdown
+# request.
+def send_request(path, request):
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+        sock.connect(path)
+        sock.sendall((json.dumps(request)+'\n').encode())
+        sock.shutdown(socket.SHUT_WR)
+        if request['query'] == 'shutdown':
+            return None
+        with sock.makefile() as f:
+            line = f.readline()
+    if not line:
+        raise RuntimeError('no response from server')
+    return json.loads(line)
+
+# Create a request from the command-line options, for a server. Options that
+# a server does not answer are an error.
+def create_request(args):
+    unsupported = [('--dump-dot', args.dump_dot),
+                   ('--comb-loops', args.comb_loops),
+                   ('--depth-stats', args.depth_stats),
+                   ('--deepest-paths', args.deepest_paths is not None),
+                   ('--cone', args.cone_points),
+                   ('--matrix', args.matrix),
+                   ('--matrix-paths', args.matrix_paths),
+                   ('--paths-exist', args.paths_exist),
+                   ('--batch', args.batch),
+                   ('--reachability-index', args.reachability_index),
+                   ('--fanout-degree without --from', args.fanout_degree and not args.start_point),
+                   ('--fanin-degree without --to', args.fanin_degree and not args.finish_point),
+                   ('--logic-depths without --to', args.logic_depths and not args.finish_point)]
+    for option, given in unsupported:
+        if given:
+            raise RuntimeError('cannot query a server with {}'.format(option))
+    request = {'id': 0, 'regex': args.regex}
+    if args.netlist:
+        request['netlist'] = args.netlist
+    if args.start_point:
+        request['from'] = args.start_point
+    if args.finish_point:
+        request['to'] = args.finish_point
+    request['through'] = [x[0] for x in args.through_points]
+    request['avoid'] = args.avoid_points
+    if args.shutdown:
+        request['query'] = 'shutdown'
+    elif args.dump_names:
+        request.update({'query': 'names', 'pattern': args.dump_names})
+    elif args.fanout_degree:
+        request['query'] = 'fanout_degree'
+    elif args.fanin_degree:
+        request['query'] = 'fanin_degree'
+    elif args.logic_depths:
+        request['query'] = 'logic_depth'
+    elif args.start_point and args.finish_point:
+        request['query'] = 'all_paths' if args.all_paths else 'any_path'
+    elif args.start_point:
+        request['query'] = 'register_fanout' if args.registers else 'fanout_paths'
+    elif args.finish_point:
+        request['query'] = 'register_fanin' if args.registers else 'fanin_paths'
+    else:
+        request['query'] = 'netlists'
+    return request
+
+# Create a netlist from an XML file or, if compile is set, a source file.
+def load_netlist(filename, compile):
+    if not compile:
+        return Netlist(filename)
+    comp = RunVerilator(defs.INSTALL_PREFIX)
+    temp_name = next(tempfile._get_candidate_names())
+    if comp.run(filename, temp_name) > 0:
+        raise RuntimeError('error compiling design')
+    try:
+        return Netlist(temp_name)
+    finally:
+        os.remove(temp_name)
+
+# Load a reachability index from a file or, if the file does not exist or is
+# older than the netlist's input file, build the index and save it to the file.
+# Any other failure to load the index is reported.
+def load_reachability_index(netlist, filename, input_filename):
+    if os.path.exists(filename) and \
+       os.path.getmtime(filename) >= os.path.getmtime(input_filename):
+        netlist.load_reachability_index(filename)
+    else:
+        netlist.build_reachability_index()
+        netlist.save_reachability_index(filename)
+
 def main():
     parser = argparse.ArgumentParser(description="Query a Verilog netlist")
     parser.add_argument('files',
-                        nargs='+',
+                        nargs='*',
                         help='Input files')
     parser.add_argument('-c', '--compile',
                         action='store_true',
@@ -79,6 +475,41 @@ def main():
     parser.add_argument('--dump-dot',
                         action='store_true',
                         help='Dump a dotfile of the netlist\'s graph')
+    parser.add_argument('--comb-loops',
+                        action='store_true',
+                        help='Report all combinational loops')
+    parser.add_argument('--fanout-degree',
+                        action='store_true',
+                        help='Report the number of finish points reachable from the start point, or from every start point')
+    parser.add_argument('--fanin-degree',
+                        action='store_true',
+                        help='Report the number of start points reaching the finish point, or every finish point')
+    parser.add_argument('--logic-depths',
+                        action='store_true',
+                        help='Report the logic depth of the finish point, or of every finish point')
+    parser.add_argument('--depth-stats',
+                        action='store_true',
+                        help='Report a histogram of finish point logic depths and per-module depth statistics')
+    parser.add_argument('--deepest-paths',
+                        type=int,
+                        default=None,
+                        metavar='K',
+                        help='Report the K paths with the largest logic depths')
+    parser.add_argument('--sort',
+                        choices=['degree', 'name'],
+                        default='degree',
+                        help='Order of the degree and depth reports (default: degree)')
+    parser.add_argument('--cone',
+                        nargs=1,
+                        action='append',
+                        dest='cone_points',
+                        default=[],
+                        metavar='point',
+                        help='Restrict the netlist to the cone of a point before other queries')
+    parser.add_argument('--cone-direction',
+                        choices=['fanin', 'fanout', 'both'],
+                        default='fanin',
+                        help='Direction of the cones of --cone points (default: fanin)')
     parser.add_argument('--from',
                         dest='start_point',
                         metavar='point',
@@ -94,12 +525,59 @@ def main():
                         default=[],
                         metavar='point',
                         help='Though point')
+    parser.add_argument('--avoid',
+                        action='append',
+                        dest='avoid_points',
+                        default=[],
+                        metavar='point',
+                        help='Avoid point (a name or pattern)')
+    parser.add_argument('--matrix',
+                        action='store_true',
+                        help='Report the connectivity of every start point matching --from to every finish point matching --to')
+    parser.add_argument('--matrix-paths',
+                        action='store_true',
+                        help='Report an example path for each connected pair of a --matrix query')
+    parser.add_argument('--paths-exist',
+                        default=None,
+                        metavar='file',
+                        help='Report whether paths exist between each pair of start and finish points in a file')
+    parser.add_argument('--batch',
+                        default=None,
+                        metavar='file',
+                        help='Answer the JSON queries in a file, one per line, writing a JSON response for each')
+    parser.add_argument('--reachability-index',
+                        default=None,
+                        metavar='file',
+                        help='Answer path existence queries with a reachability index, loaded from file, or built and saved to it if the file is missing or older than the input file')
     parser.add_argument('--all-paths',
                         action='store_true',
                         help='Find all paths between two points (exponential time)')
+    parser.add_argument('--registers',
+                        action='store_true',
+                        help='Report the registers and ports fanning out or in, rather than paths')
     parser.add_argument('--regex',
                         action='store_true',
                         help='Enable regular expression matching of names')
+    parser.add_argument('--serve',
+                        default=None,
+                        metavar='socket',
+                        help='Load each input file once and answer JSON queries on a Unix domain socket')
+    parser.add_argument('--connect',
+                        default=None,
+                        metavar='socket',
+                        help='Send the query to a server and print its JSON response')
+    parser.add_argument('--shutdown',
+                        action='store_true',
+                        help='Stop the server given by --connect')
+    parser.add_argument('--netlist',
+                        default=None,
+                        metavar='name',
+                        help='Name of the netlist to query on a server (the input file name without extension)')
+    parser.add_argument('-j', '--threads',
+                        type=int,
+                        default=0,
+                        metavar='N',
+                        help='Number of threads to use (default: all cores)')
     parser.add_argument('-v', '--verbose',
                         action='store_true',
                         help='Print execution information')
@@ -114,7 +592,24 @@ def main():
         Options.get_instance().set_verbose()
     if args.debug:
         Options.get_instance().set_debug()
+    Options.get_instance().set_num_threads(args.threads)
     try:
+        # Query a server
+        if args.connect:
+            response = send_request(args.connect, create_request(args))
+            if response is None:
+                return 0
+            print(json.dumps(response))
+            return 1 if 'error' in response else 0
+        if len(args.files) == 0:
+            raise RuntimeError('no input files')
+        # Serve queries
+        if args.serve:
+            netlists = {}
+            for filename in args.files:
+                name = os.path.splitext(os.path.basename(filename))[0]
+                netlists[name] = load_netlist(filename, args.compile)
+            return serve(netlists, args.serve, args.threads or os.cpu_count())
         # Verilator compilation
         # (Only support one source file.)
         if (args.compile):
@@ -123,17 +618,33 @@ def main():
             if comp.run(args.files[0], temp_name) > 0:
                 raise RuntimeError('error compiling design')
         # Create the netlist
-        netlist = Netlist(temp_name)
+        netlist = Netlist(temp_name if args.compile else args.files[0])
         # If compiling and no no further steps performed and an output file is
         # specified, rename XML to the output, otherwise delete it.
         if args.compile:
             if args.output_file and \
               not args.dump_names and \
               not args.dump_dot and \
+              not args.comb_loops and \
+              not args.fanout_degree and \
+              not args.fanin_degree and \
+              not args.logic_depths and \
+              not args.depth_stats and \
+              args.deepest_paths is None and \
+              not args.paths_exist and \
+              not args.batch and \
               not (args.start_point or args.finish_point):
                 os.rename(temp_name, args.output_file)
             else:
                 os.remove(temp_name)
+        # Cone of influence
+        if args.cone_points:
+            netlist = netlist.extract_cone([x[0] for x in args.cone_points],
+                                           args.cone_direction in ('fanin', 'both'),
+                                           args.cone_direction in ('fanout', 'both'))
+        # Reachability index
+        if args.reachability_index:
+            load_reachability_index(netlist, args.reachability_index, args.files[0])
         # Dump names
         if args.dump_names:
             dump_names(netlist, args.dump_names, sys.stdout)
@@ -141,15 +652,63 @@ def main():
         if args.dump_dot:
             netlist.dump_dot_file(args.output_file if args.output_file else DEFAULT_DOT_FILE)
             return 0
+        # Combinational loops
+        if args.comb_loops:
+            dump_comb_loops_report(netlist, sys.stdout)
+            return 0
+        # Fan out and fan in degrees
+        if args.fanout_degree:
+            if args.start_point:
+                print(netlist.get_fanout_degree(args.start_point))
+            else:
+                dump_count_report(netlist, netlist.get_all_fanout_degrees(), 'Degree', args.sort, sys.stdout)
+            return 0
+        if args.fanin_degree:
+            if args.finish_point:
+                print(netlist.get_fanin_degree(args.finish_point))
+            else:
+                dump_count_report(netlist, netlist.get_all_fanin_degrees(), 'Degree', args.sort, sys.stdout)
+            return 0
+        # Logic depths
+        if args.logic_depths:
+            if args.finish_point:
+                print(netlist.get_logic_depth(args.finish_point))
+            else:
+                dump_count_report(netlist, netlist.get_all_logic_depths(), 'Depth', args.sort, sys.stdout)
+            return 0
+        if args.depth_stats:
+            dump_depth_stats_report(netlist, sys.stdout)
+            return 0
+        if args.deepest_paths is not None:
+            dump_deepest_paths_report(netlist, args.deepest_paths, sys.stdout)
+            return 0
+        # Batched path existence
+        if args.paths_exist:
+            dump_paths_exist_report(netlist, args.paths_exist, sys.stdout)
+            return 0
+        # Batched queries
+        if args.batch:
+            name = os.path.splitext(os.path.basename(args.files[0]))[0]
+            dump_batch_report(netlist, name, args.batch,
+                              args.threads or os.cpu_count(), sys.stdout)
+            return 0
+        # Connectivity matrix
+        if args.matrix or args.matrix_paths:
+            if not (args.start_point and args.finish_point):
+                raise RuntimeError('a matrix query requires a start and finish point')
+            if len(args.through_points) > 0:
+                raise RuntimeError('cannot specify through points with a matrix query')
+            dump_path_matrix_report(netlist, args.start_point, args.finish_point,
+                                    args.matrix_paths, args.avoid_points, sys.stdout)
+            return 0
         # Point-to-point path
         if args.start_point and args.finish_point:
-            waypoints = Waypoints()
-            waypoints.add_start_point(args.start_point)
-            waypoints.add_finish_point(args.finish_point)
-            [waypoints.add_through_point(point) for point in args.through_points]
+            waypoints = create_waypoints(args.start_point, args.finish_point,
+                                         [x[0] for x in args.through_points],
+                                         args.avoid_points)
             if args.all_paths:
-                path = netlist.get_all_paths(waypoints)
-                dump_path_list_report(netlist, path, sys.stdout)
+                paths = netlist.iter_all_paths(waypoints)
+                dump_path_list_report(netlist, paths, sys.stdout)
             else:
                 path = netlist.get_any_path(waypoints)
                 dump_path_report(netlist, path, sys.stdout)
@@ -158,14 +717,24 @@ def main():
         if args.start_point and not args.finish_point:
             if len(args.through_points) > 0:
                 raise RuntimeError('cannot specify through points with fanout paths')
-            paths = netlist.get_all_fanout_paths(args.start_point)
+            if args.registers:
+                if len(args.avoid_points) > 0:
+                    raise RuntimeError('cannot specify avoid points with register fanout')
+                dump_register_report(netlist, netlist.get_register_fanout(args.start_point), sys.stdout)
+                return 0
+            paths = netlist.iter_all_fanout_paths(args.start_point, args.avoid_points)
             dump_path_list_report(netlist, paths, sys.stdout)
             return 0
         # Fan in paths
         if args.finish_point and not args.start_point:
             if len(args.through_points) > 0:
                 raise RuntimeError('cannot specify through points with fanin paths')
-            paths = netlist.get_all_fanin_paths(args.finish_point)
+            if args.registers:
+                if len(args.avoid_points) > 0:
+                    raise RuntimeError('cannot specify avoid points with register fanin')
+                dump_register_report(netlist, netlist.get_register_fanin(args.finish_point), sys.stdout)
+                return 0
+            paths = netlist.iter_all_fanin_paths(args.finish_point, args.avoid_points)
             dump_path_list_report(netlist, paths, sys.stdout)
             return 0
     except RuntimeError as e: